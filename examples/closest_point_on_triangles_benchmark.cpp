@@ -0,0 +1,166 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/closest_point.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/closest_points_on_triangles.hpp"
+#include "trueform/distance.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/nearness_search.hpp"
+#include "trueform/nearness_search_broad.hpp"
+#include "trueform/normalized.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  constexpr std::size_t lanes = 4;
+  tf::tree<int, float, 3> mesh_tree;
+  // leaves hold at most as many triangles as there are lanes
+  mesh_tree.build(triangles,
+                  tf::config_tree(4, lanes, [&points = points](
+                                                const triangle_t &t) {
+                    return tf::aabb_union(
+                        tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                       points[t[1]]),
+                        points[t[2]]);
+                  }));
+  std::cout << "Build triangle tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  auto center = mesh_tree.nodes().front().aabb.center();
+  auto radius = mesh_tree.nodes().front().aabb.diagonal().length() / 2;
+  auto random_query = [&] {
+    return center + tf::normalized(tf::random_vector<float, 3>()) * radius *
+                        std::sqrt(tf::random<float>(0, 1));
+  };
+
+  std::cout << "Closest points of one random query point per triangle, "
+               "scalar and in blocks of "
+            << lanes << " lanes." << std::endl;
+  const int n_rounds = 20;
+  std::vector<tf::vector<float, 3>> queries;
+  queries.reserve(triangles.size());
+  for (std::size_t i = 0; i < triangles.size(); ++i)
+    queries.push_back(random_query());
+
+  float scalar_sum = 0;
+  tf::tick();
+  for (int round = 0; round < n_rounds; ++round)
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+      auto cpt = tf::closest_point_on_triangle(
+          tf::make_indirect_range(triangles[i], points), queries[i]);
+      scalar_sum += (cpt - queries[i]).length2();
+    }
+  auto scalar_time = tf::tock();
+
+  // the triangles and queries are laid out in blocks
+  // of lanes once, as a mesh processing pipeline would
+  std::size_t n_blocks = (triangles.size() + lanes - 1) / lanes;
+  std::vector<std::array<tf::point_lanes<float, lanes>, 4>> blocks(n_blocks);
+  for (std::size_t i = 0; i < n_blocks * lanes; ++i) {
+    auto id = std::min(i, triangles.size() - 1);
+    auto &block = blocks[i / lanes];
+    for (int v = 0; v < 3; ++v)
+      tf::set_lane(block[v], i % lanes, points[triangles[id][v]]);
+    tf::set_lane(block[3], i % lanes, queries[id]);
+  }
+  float lanes_sum = 0;
+  tf::point_lanes<float, lanes> closest;
+  std::array<float, lanes> distances2;
+  tf::tick();
+  for (int round = 0; round < n_rounds; ++round)
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      const auto &block = blocks[b];
+      tf::closest_points_on_triangles(block[0], block[1], block[2], block[3],
+                                      closest, distances2);
+      auto n = std::min(lanes, triangles.size() - b * lanes);
+      for (std::size_t i = 0; i < n; ++i)
+        lanes_sum += distances2[i];
+    }
+  auto lanes_time = tf::tock();
+  std::cout << "  scalar: " << scalar_time << " ms" << std::endl;
+  std::cout << "  lanes : " << lanes_time << " ms" << std::endl;
+  std::cout << "  relative difference of the sums of squared distances: "
+            << std::abs(lanes_sum - scalar_sum) / scalar_sum << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  const int n_queries = 100000;
+  std::cout << "Closest point on the mesh for " << n_queries
+            << " random points, one triangle per call and one leaf per call."
+            << std::endl;
+  std::vector<tf::vector<float, 3>> mesh_queries;
+  mesh_queries.reserve(n_queries);
+  for (int i = 0; i < n_queries; ++i)
+    mesh_queries.push_back(random_query());
+
+  float max_difference = 0;
+  std::vector<float> scalar_distances(n_queries);
+  tf::tick();
+  for (int i = 0; i < n_queries; ++i) {
+    const auto &query_pt = mesh_queries[i];
+    auto result = tf::nearness_search(
+        mesh_tree,
+        [&query_pt](const tf::aabb<float, 3> &aabb) {
+          return tf::distance2(aabb, query_pt);
+        },
+        [&](int triangle_id) {
+          auto cpt = tf::closest_point_on_triangle(
+              tf::make_indirect_range(triangles[triangle_id], points),
+              query_pt);
+          return tf::make_closest_point((cpt - query_pt).length2(), cpt);
+        });
+    scalar_distances[i] = std::sqrt(result.metric());
+  }
+  auto search_time = tf::tock();
+
+  tf::point_lanes<float, lanes> a, b, c, query_lanes;
+  tf::tick();
+  for (int i = 0; i < n_queries; ++i) {
+    const auto &query_pt = mesh_queries[i];
+    tf::broadcast_lanes(query_lanes, query_pt);
+    auto result = tf::nearness_search_broad(
+        mesh_tree,
+        [&query_pt](const tf::aabb<float, 3> &aabb) {
+          return tf::distance2(aabb, query_pt);
+        },
+        [&](const auto &ids, auto closest_points) {
+          // unused lanes repeat the last triangle of the leaf
+          for (std::size_t l = 0; l < lanes; ++l) {
+            const auto &triangle =
+                triangles[ids[std::min<std::size_t>(l, ids.size() - 1)]];
+            tf::set_lane(a, l, points[triangle[0]]);
+            tf::set_lane(b, l, points[triangle[1]]);
+            tf::set_lane(c, l, points[triangle[2]]);
+          }
+          tf::closest_points_on_triangles(a, b, c, query_lanes, closest,
+                                          distances2);
+          for (std::size_t l = 0; l < std::size_t(ids.size()); ++l)
+            closest_points[l] =
+                tf::make_closest_point(distances2[l], tf::get_lane(closest, l));
+        });
+    max_difference = std::max(max_difference,
+                              std::abs(std::sqrt(result.metric()) -
+                                       scalar_distances[i]));
+  }
+  auto broad_time = tf::tock();
+  std::cout << "  nearness_search      : " << search_time << " ms" << std::endl;
+  std::cout << "  nearness_search_broad: " << broad_time << " ms" << std::endl;
+  std::cout << "  max difference of distances: " << max_difference
+            << std::endl;
+}
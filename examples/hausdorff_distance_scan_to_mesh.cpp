@@ -0,0 +1,94 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/hausdorff_distance.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/nearness_search.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> mesh_tree;
+  mesh_tree.build(
+      triangles, tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+        return tf::aabb_union(
+            tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                           points[t[1]]),
+            points[t[2]]);
+      }));
+  std::cout << "Build triangle tree." << std::endl;
+
+  // simulate a registered scan by perturbing the vertices of the mesh
+  auto noise = mesh_tree.nodes().front().aabb.diagonal().length() / 1000;
+  std::vector<tf::vector<float, 3>> scan;
+  scan.reserve(points.size());
+  for (const auto &pt : points)
+    scan.push_back(pt + tf::random_vector<float, 3>() * noise);
+
+  tf::tree<int, float, 3> scan_tree;
+  scan_tree.build(scan,
+                  tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+                    return tf::aabb_from(pt);
+                  }));
+  std::cout << "Build scan tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  auto closest_pts_f = [&](int scan_id, int triangle_id) {
+    const auto &query_pt = scan[scan_id];
+    auto cpt = tf::closest_point_on_triangle(
+        tf::make_indirect_range(triangles[triangle_id], points), query_pt);
+    return tf::make_closest_point_pair((cpt - query_pt).length2(), query_pt,
+                                       cpt);
+  };
+
+  // the search of each scan point starts from the triangle closest to the
+  // previous one, and stops once it can not raise the distance
+  tf::tick();
+  auto [elements, closest_pts] =
+      tf::directed_hausdorff_distance(scan_tree, mesh_tree, closest_pts_f);
+  auto time = tf::tock();
+  std::cout << "Directed Hausdorff distance (scan -> mesh): "
+            << std::sqrt(closest_pts.metric) << std::endl;
+  std::cout << "  realized by scan point " << elements.first
+            << " and triangle " << elements.second << std::endl;
+  std::cout << "  computed in " << time << " ms" << std::endl;
+
+  std::cout << "---------------------------------" << std::endl;
+  std::cout << "Compare to a closest point query for every scan point"
+            << std::endl;
+  tf::tick();
+  float metric = 0;
+  for (int scan_id = 0; scan_id < int(scan.size()); ++scan_id) {
+    const auto &query_pt = scan[scan_id];
+    auto result = tf::nearness_search(
+        mesh_tree,
+        [&query_pt](const tf::aabb<float, 3> &aabb) {
+          return tf::distance2(aabb, query_pt);
+        },
+        [&](int triangle_id) {
+          auto cpt = closest_pts_f(scan_id, triangle_id);
+          return tf::make_closest_point(cpt.metric, cpt.second);
+        });
+    metric = std::max(metric, result.metric());
+  }
+  time = tf::tock();
+  std::cout << "  distance: " << std::sqrt(metric) << std::endl;
+  std::cout << "  computed in " << time << " ms" << std::endl;
+}
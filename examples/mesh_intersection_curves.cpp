@@ -0,0 +1,76 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/mesh_intersection_curves.hpp"
+#include "trueform/random_transformation.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  auto build_tree = [](const auto &triangles, const auto &points) {
+    tf::tree<int, float, 3> tree;
+    tree.build(triangles, tf::config_tree(4, 4, [&points](const triangle_t &t) {
+                 return tf::aabb_union(
+                     tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                    points[t[1]]),
+                     points[t[2]]);
+               }));
+    return tree;
+  };
+  auto tree = build_tree(triangles, points);
+
+  std::cout << "We will cut the mesh with a grid of triangles in a plane "
+               "through its center, at a random orientation."
+            << std::endl;
+  auto center = tree.nodes().front().aabb.center();
+  auto radius = tree.nodes().front().aabb.diagonal().length() / 2;
+  auto frame = tf::random_transformation(center);
+  const int n = 100;
+  std::vector<tf::vector<float, 3>> plane_points;
+  std::vector<triangle_t> plane_triangles;
+  for (int i = 0; i <= n; ++i)
+    for (int j = 0; j <= n; ++j)
+      plane_points.push_back(frame.transform_point(tf::make_vector<float, 3>(
+          {radius * (2.f * i / n - 1), radius * (2.f * j / n - 1), 0.f})));
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) {
+      int v = i * (n + 1) + j;
+      plane_triangles.push_back({v, v + n + 1, v + 1});
+      plane_triangles.push_back({v + 1, v + n + 1, v + n + 2});
+    }
+  auto plane_tree = build_tree(plane_triangles, plane_points);
+  std::cout << "  number of plane triangles: " << plane_triangles.size()
+            << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  tf::tick();
+  auto curves = tf::mesh_intersection_curves(tree, triangles, points,
+                                             plane_tree, plane_triangles,
+                                             plane_points);
+  auto time = tf::tock();
+  std::cout << "Computed " << curves.offsets.size() - 1
+            << " intersection polylines with " << curves.points.size()
+            << " points in " << time << " ms." << std::endl;
+  for (auto polyline : curves.polylines()) {
+    bool closed = polyline.size() > 2 &&
+                  polyline.front()[0] == polyline.back()[0] &&
+                  polyline.front()[1] == polyline.back()[1] &&
+                  polyline.front()[2] == polyline.back()[2];
+    std::cout << "  " << (closed ? "closed" : "open") << " polyline of "
+              << polyline.size() << " points" << std::endl;
+  }
+}
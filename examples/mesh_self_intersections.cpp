@@ -0,0 +1,65 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/mesh_self_intersections.hpp"
+#include "trueform/random.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  auto build_tree = [&triangles = triangles](const auto &points) {
+    tf::tree<int, float, 3> tree;
+    tree.build(triangles, tf::config_tree(4, 4, [&points](const triangle_t &t) {
+                 return tf::aabb_union(
+                     tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                    points[t[1]]),
+                     points[t[2]]);
+               }));
+    return tree;
+  };
+
+  auto tree = build_tree(points);
+  tf::tick();
+  auto pairs = tf::mesh_self_intersections(tree, triangles, points);
+  auto time = tf::tock();
+  std::cout << "Found " << pairs.size()
+            << " pairs of intersecting triangles in the input mesh, in "
+            << time << " ms." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  std::cout << "We will push 20 random points of the mesh through its surface, "
+               "to create self-intersections."
+            << std::endl;
+  auto extent = tree.nodes().front().aabb.diagonal().length();
+  for (int i = 0; i < 20; ++i) {
+    auto &pt = points[tf::random<int>(0, points.size() - 1)];
+    auto mv = tf::random_vector<3>(-1.f, 1.f);
+    mv /= mv.length();
+    pt += mv * 0.1f * extent;
+  }
+  tree = build_tree(points);
+  tf::tick();
+  pairs = tf::mesh_self_intersections(tree, triangles, points);
+  time = tf::tock();
+  std::cout << "Found " << pairs.size()
+            << " pairs of intersecting triangles in the perturbed mesh, in "
+            << time << " ms." << std::endl;
+  for (std::size_t i = 0; i < std::min<std::size_t>(pairs.size(), 10); ++i)
+    std::cout << "  " << pairs[i][0] << ", " << pairs[i][1] << std::endl;
+  if (pairs.size() > 10)
+    std::cout << "  ..." << std::endl;
+}
@@ -0,0 +1,117 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/approximation.hpp"
+#include "trueform/closest_point.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/distance.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/nearness_search.hpp"
+#include "trueform/normalized.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> mesh_tree;
+  mesh_tree.build(
+      triangles, tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+        return tf::aabb_union(
+            tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                           points[t[1]]),
+            points[t[2]]);
+      }));
+  std::cout << "Build triangle tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  const int n_queries = 100000;
+  std::cout << "We will compute the closest point on the mesh for "
+            << n_queries
+            << " random points in the sphere enclosing the mesh, exactly "
+               "and approximately."
+            << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  auto center = mesh_tree.nodes().front().aabb.center();
+  auto radius = mesh_tree.nodes().front().aabb.diagonal().length() / 2;
+  std::vector<tf::vector<float, 3>> queries;
+  queries.reserve(n_queries);
+  for (int i = 0; i < n_queries; ++i)
+    queries.push_back(center +
+                      tf::normalized(tf::random_vector<float, 3>()) * radius *
+                          std::sqrt(tf::random<float>(0, 1)));
+
+  auto aabb_metric_f = [](const auto &query_pt) {
+    return [&query_pt](const tf::aabb<float, 3> &aabb) {
+      return tf::distance2(aabb, query_pt);
+    };
+  };
+  auto closest_point_f = [&points = points,
+                          &triangles = triangles](const auto &query_pt) {
+    return [&query_pt, &points, &triangles](const auto &triangle_id) {
+      auto cpt = tf::closest_point_on_triangle(
+          tf::make_indirect_range(triangles[triangle_id], points), query_pt);
+      return tf::make_closest_point((cpt - query_pt).length2(), cpt);
+    };
+  };
+
+  std::vector<float> exact(n_queries);
+  auto run = [&](std::string name, const auto &search_f) {
+    float max_error = 0;
+    tf::tick();
+    for (int i = 0; i < n_queries; ++i) {
+      auto distance = std::sqrt(search_f(queries[i]).metric());
+      if (name == "exact")
+        exact[i] = distance;
+      else if (exact[i] > 0)
+        max_error = std::max(max_error, distance / exact[i] - 1);
+    }
+    auto time = tf::tock();
+    std::cout << "  " << name << ": " << time << " ms, max relative error "
+              << max_error << std::endl;
+  };
+
+  auto benchmark = [&](auto strategy, std::string name) {
+    std::cout << "Strategy " << name << ":" << std::endl;
+    run("exact", [&](const auto &query_pt) {
+      return tf::nearness_search(strategy, mesh_tree, aabb_metric_f(query_pt),
+                                 closest_point_f(query_pt));
+    });
+    // nodes are pruned once they can not improve
+    // the result by more than a factor of (1 + epsilon)
+    run("epsilon = 0.1", [&](const auto &query_pt) {
+      return tf::nearness_search(strategy, mesh_tree, aabb_metric_f(query_pt),
+                                 closest_point_f(query_pt),
+                                 tf::make_approximation(0.1f));
+    });
+    run("epsilon = 0.5", [&](const auto &query_pt) {
+      return tf::nearness_search(strategy, mesh_tree, aabb_metric_f(query_pt),
+                                 closest_point_f(query_pt),
+                                 tf::make_approximation(0.5f));
+    });
+    // additionally, the number of evaluated primitives may be capped
+    run("epsilon = 0.1, at most 16 evaluations", [&](const auto &query_pt) {
+      return tf::nearness_search(strategy, mesh_tree, aabb_metric_f(query_pt),
+                                 closest_point_f(query_pt),
+                                 tf::make_approximation(0.1f, 16));
+    });
+    std::cout << "---------------------------------" << std::endl;
+  };
+  benchmark(tf::strategy::top_k_sorted, "top_k_sorted");
+  benchmark(tf::strategy::priority_queue, "priority_queue");
+}
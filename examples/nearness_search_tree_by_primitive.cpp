@@ -3,6 +3,7 @@
 #include "trueform/closest_point_on_triangle.hpp"
 #include "trueform/distance.hpp"
 #include "trueform/indirect_range.hpp"
+#include "trueform/nearness_hint.hpp"
 #include "trueform/nearness_search.hpp"
 #include "trueform/normalized.hpp"
 #include "trueform/random_vector.hpp"
@@ -64,6 +65,33 @@ int main(int argc, char *argv[]) {
   std::cout << "At distance: " << std::sqrt(metric) << " from query_pt"
             << std::endl;
 
+  std::cout << "---------------------------------" << std::endl;
+  std::cout << "Move the query point slightly, and warm-start the query "
+               "with the previous result"
+            << std::endl;
+
+  // the hinted primitive is evaluated first, so that
+  // the traversal starts with a tight bound
+  auto moved_pt = query_pt + tf::normalized(tf::random_vector<float, 3>()) *
+                                 (radius / 1000);
+  auto moved_closest_point = tf::nearness_search(
+      mesh_tree,
+      [moved_pt](const tf::aabb<float, 3> &aabb) {
+        return tf::distance2(aabb, moved_pt);
+      },
+      [&moved_pt, &points = points,
+       &triangles = triangles](const auto &triangle_id) {
+        auto cpt = tf::closest_point_on_triangle(
+            tf::make_indirect_range(triangles[triangle_id], points), moved_pt);
+        return tf::make_closest_point((cpt - moved_pt).length2(), cpt);
+      },
+      tf::make_nearness_hint(primitive_id));
+
+  std::cout << "Closest point on primitive: " << moved_closest_point.element
+            << std::endl;
+  std::cout << "At distance: " << std::sqrt(moved_closest_point.metric())
+            << " from moved_pt" << std::endl;
+
   std::cout << "---------------------------------" << std::endl;
   std::cout << "Now we will compute 4 nearest points" << std::endl;
   std::cout << "(If the closest point is on a vertex, these might be the same)"
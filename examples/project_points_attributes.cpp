@@ -0,0 +1,115 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/nearness_search.hpp"
+#include "trueform/project_points.hpp"
+#include "trueform/random.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> tree;
+  tree.build(triangles,
+             tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+               return tf::aabb_union(
+                   tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                  points[t[1]]),
+                   points[t[2]]);
+             }));
+  std::cout << "Build tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // the vertices of a target mesh that approximates the source, in the
+  // arbitrary order of a scan
+  const int n_queries = 200000;
+  auto extent = tree.nodes().front().aabb.diagonal().length();
+  std::vector<tf::vector<float, 3>> queries;
+  queries.reserve(n_queries);
+  for (int i = 0; i < n_queries; ++i)
+    queries.push_back(points[tf::random<int>(0, points.size() - 1)] +
+                      tf::random_vector<3>(-1.f, 1.f) * (extent * 1e-2f));
+  std::cout << "Projecting " << n_queries << " points near the mesh."
+            << std::endl;
+
+  tf::tick();
+  std::vector<float> distances(n_queries);
+  for (int i = 0; i < n_queries; ++i) {
+    const auto &query_pt = queries[i];
+    auto result = tf::nearness_search(
+        tree,
+        [&query_pt](const tf::aabb<float, 3> &aabb) {
+          return tf::distance2(aabb, query_pt);
+        },
+        [&](int triangle_id) {
+          auto cpt = tf::closest_point_on_triangle(
+              tf::make_indirect_range(triangles[triangle_id], points),
+              query_pt);
+          return tf::make_closest_point((cpt - query_pt).length2(), cpt);
+        });
+    distances[i] = std::sqrt(result.metric());
+  }
+  auto search_time = tf::tock();
+
+  tf::tick();
+  auto projections = tf::project_points(tree, triangles, points, queries);
+  auto project_time = tf::tock();
+
+  float max_difference = 0;
+  for (int i = 0; i < n_queries; ++i)
+    max_difference =
+        std::max(max_difference,
+                 std::abs((projections.points[i] - queries[i]).length() -
+                          distances[i]));
+  std::cout << "  nearness_search per point: " << search_time << " ms"
+            << std::endl;
+  std::cout << "  project_points           : " << project_time << " ms"
+            << std::endl;
+  std::cout << "  max difference of distances: " << max_difference
+            << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  std::cout << "Transferring per-vertex attributes." << std::endl;
+  // a scalar field and the positions themselves, which must interpolate to
+  // the projected points
+  std::vector<float> heights(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    heights[i] = points[i][2];
+  tf::tick();
+  auto transferred_heights =
+      tf::interpolate_attributes(projections, triangles, heights);
+  auto transferred_points =
+      tf::interpolate_attributes(projections, triangles, points);
+  auto interpolate_time = tf::tock();
+
+  float max_height_error = 0, max_point_error = 0;
+  for (int i = 0; i < n_queries; ++i) {
+    max_height_error =
+        std::max(max_height_error, std::abs(transferred_heights[i] -
+                                            projections.points[i][2]));
+    max_point_error = std::max(
+        max_point_error,
+        (transferred_points[i] - projections.points[i]).length());
+  }
+  std::cout << "  interpolated in " << interpolate_time << " ms" << std::endl;
+  std::cout << "  max error of heights  : " << max_height_error << std::endl;
+  std::cout << "  max error of positions: " << max_point_error << std::endl;
+}
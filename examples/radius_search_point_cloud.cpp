@@ -0,0 +1,67 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/buffer.hpp"
+#include "trueform/offset_block_range.hpp"
+#include "trueform/radius_search.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  tf::tree<int, float, 3> tree;
+  tree.build(tf::strategy::floyd_rivest, points,
+             tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+               return tf::aabb_from(pt);
+             }));
+  std::cout << "Build point tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // use a radius relative to the size of the cloud
+  auto radius = tree.nodes().front().aabb.diagonal().length() / 100;
+  std::cout << "We will collect the neighborhood within radius " << radius
+            << " of every point in the cloud." << std::endl;
+
+  // queries are processed in parallel. Results are collected
+  // in thread-local buffers, which are concatenated at the end
+  tf::buffer<int> offsets;
+  tf::buffer<int> ids;
+  tf::buffer<float> metrics;
+  tf::radius_search(tree, points, points, radius, offsets, ids, metrics);
+
+  // the same can be done for arbitrary primitives, by providing
+  // (query, aabb) -> metric and (query, id) -> tf::closest_point functions
+  //
+  // tf::radius_search(tree, queries, aabb_metric_f, closest_point_f,
+  //                   radius, offsets, ids, metrics);
+
+  auto neighborhoods = tf::make_offset_block_range(offsets, ids);
+  std::size_t max_size = 0;
+  for (const auto &neighborhood : neighborhoods)
+    max_size = std::max(max_size, std::size_t(neighborhood.size()));
+
+  std::cout << "---------------------------------" << std::endl;
+  std::cout << "Found " << ids.size() << " neighbors in total" << std::endl;
+  std::cout << "  average neighborhood size: "
+            << float(ids.size()) / neighborhoods.size() << std::endl;
+  std::cout << "  largest neighborhood size: " << max_size << std::endl;
+
+  std::cout << "---------------------------------" << std::endl;
+  std::cout << "A single query appends into the buffers:" << std::endl;
+  tf::buffer<int> query_ids;
+  tf::buffer<float> query_metrics;
+  tf::radius_search(tree, points, points.front(), radius, query_ids,
+                    query_metrics);
+  std::cout << "  point 0 has " << query_ids.size() << " neighbors"
+            << std::endl;
+}
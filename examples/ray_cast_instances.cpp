@@ -0,0 +1,96 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/closest_point.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/distance.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/nearness_search.hpp"
+#include "trueform/random_transformation.hpp"
+#include "trueform/ray.hpp"
+#include "trueform/ray_cast.hpp"
+#include "trueform/transformed.hpp"
+#include "trueform/transformed_tree.hpp"
+#include "trueform/tree.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> mesh_tree;
+  mesh_tree.build(
+      triangles, tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+        return tf::aabb_union(
+            tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                           points[t[1]]),
+            points[t[2]]);
+      }));
+  std::cout << "Build triangle tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // place instances of the mesh on a grid, each with a random rotation.
+  // All instances share the same tree
+  auto size = mesh_tree.nodes().front().aabb.diagonal().length();
+  const int grid = 10;
+  std::vector<tf::transformed_tree<int, float, 3>> instances;
+  for (int i = 0; i < grid; ++i)
+    for (int j = 0; j < grid; ++j)
+      instances.push_back(tf::make_transformed_tree(
+          mesh_tree, tf::random_transformation<float>(tf::make_vector(
+                         std::array<float, 3>{i * size, j * size, 0}))));
+  std::cout << "Placed " << instances.size()
+            << " instances of the mesh, sharing one tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // rays are transformed into the local frame of
+  // each instance once, instead of every node box
+  auto ray_hit_f = [&points = points, &triangles = triangles](
+                       int triangle_id, const tf::ray<float, 3> &local_ray) {
+    auto t = tf::ray_triangle_parameter(
+        local_ray, tf::make_indirect_range(triangles[triangle_id], points));
+    return tf::make_closest_point(t, local_ray.point_at(t));
+  };
+  int n_hits = 0;
+  for (int i = 0; i < grid; ++i)
+    for (int j = 0; j < grid; ++j) {
+      // a ray shot down onto every instance
+      auto ray = tf::make_ray(
+          tf::make_vector(std::array<float, 3>{i * size, j * size, size}),
+          tf::make_vector(std::array<float, 3>{0, 0, -1}));
+      tf::tree_closest_point<int, float, 3> first_hit;
+      for (const auto &instance : instances) {
+        auto hit = tf::ray_cast(instance, ray, ray_hit_f);
+        if (hit && (!first_hit || hit.metric() < first_hit.metric()))
+          first_hit = hit;
+      }
+      n_hits += bool(first_hit);
+    }
+  std::cout << "Rays hitting the scene: " << n_hits << " of " << grid * grid
+            << std::endl;
+
+  // closest points are evaluated in the local frame, and
+  // reported in the world frame
+  auto query_pt = tf::make_vector(std::array<float, 3>{0, 0, size});
+  auto closest = tf::nearness_search(
+      instances.front(), query_pt,
+      [&points = points, &triangles = triangles](
+          int triangle_id, const tf::vector<float, 3> &local_pt) {
+        auto cpt = tf::closest_point_on_triangle(
+            tf::make_indirect_range(triangles[triangle_id], points), local_pt);
+        return tf::make_closest_point((cpt - local_pt).length2(), cpt);
+      });
+  auto [metric, point] = closest.point;
+  std::cout << "Closest point on the first instance: " << point[0] << ", "
+            << point[1] << ", " << point[2] << std::endl;
+  std::cout << "At distance: " << std::sqrt(metric) << std::endl;
+}
@@ -0,0 +1,102 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/mesh_pseudonormals.hpp"
+#include "trueform/sdf_grid.hpp"
+#include "trueform/signed_distance.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> tree;
+  tree.build(triangles,
+             tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+               return tf::aabb_union(
+                   tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                  points[t[1]]),
+                   points[t[2]]);
+             }));
+  tf::mesh_pseudonormals<int, float> normals;
+  normals.build(triangles, points);
+  std::cout << "Build tree and pseudonormals." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // pad the box of the mesh by a tenth of its size on each side
+  auto aabb = tree.nodes().front().aabb;
+  auto padding = aabb.diagonal() * 0.1f;
+  aabb.min = aabb.min - padding;
+  aabb.max = aabb.max + padding;
+  const int resolution = 64;
+  auto size = aabb.diagonal();
+  auto spec = tf::make_grid_spec(
+      aabb, *std::max_element(size.begin(), size.end()) / (resolution - 1));
+  std::cout << "Computing the signed distance field on a grid of "
+            << spec.dims[0] << " x " << spec.dims[1] << " x " << spec.dims[2]
+            << " samples." << std::endl;
+
+  std::vector<tf::vector<float, 3>> samples;
+  samples.reserve(spec.size());
+  for (int k = 0; k < spec.dims[2]; ++k)
+    for (int j = 0; j < spec.dims[1]; ++j)
+      for (int i = 0; i < spec.dims[0]; ++i)
+        samples.push_back(spec.origin +
+                          tf::make_vector<float, 3>({float(i), float(j),
+                                                     float(k)}) *
+                              spec.spacing);
+  tf::tick();
+  auto per_sample =
+      tf::signed_distances(tree, triangles, points, normals, samples);
+  auto per_sample_time = tf::tock();
+
+  tf::tick();
+  auto grid = tf::sdf_grid(tree, triangles, points, normals, spec);
+  auto grid_time = tf::tock();
+
+  float max_difference = 0;
+  for (std::size_t i = 0; i < spec.size(); ++i)
+    max_difference =
+        std::max(max_difference, std::abs(grid[i] - per_sample[i].distance));
+  std::cout << "  signed_distances per sample: " << per_sample_time << " ms"
+            << std::endl;
+  std::cout << "  sdf_grid                   : " << grid_time << " ms"
+            << std::endl;
+  std::cout << "  max difference: " << max_difference << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  spec.band = 3 * spec.spacing;
+  std::cout << "Computing only a narrow band of 3 samples around the surface."
+            << std::endl;
+  tf::tick();
+  auto band_grid = tf::sdf_grid(tree, triangles, points, normals, spec);
+  auto band_time = tf::tock();
+
+  max_difference = 0;
+  int n_in_band = 0;
+  for (std::size_t i = 0; i < spec.size(); ++i) {
+    auto expected =
+        std::clamp(per_sample[i].distance, -spec.band, spec.band);
+    max_difference =
+        std::max(max_difference, std::abs(band_grid[i] - expected));
+    n_in_band += std::abs(band_grid[i]) < spec.band;
+  }
+  std::cout << "  sdf_grid with a band: " << band_time << " ms" << std::endl;
+  std::cout << "  samples within the band: " << n_in_band << std::endl;
+  std::cout << "  max difference to the clamped field: " << max_difference
+            << std::endl;
+}
@@ -0,0 +1,100 @@
+#include "trueform/distance.hpp"
+#include "trueform/maximal_distance.hpp"
+#include "trueform/mod_tree.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/search_count.hpp"
+#include "trueform/search_self_count.hpp"
+#include "trueform/tree.hpp"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+int main() {
+  std::size_t n_points = 2000;
+  std::vector<tf::vector<float, 3>> points;
+  points.reserve(n_points);
+  for (std::size_t i = 0; i < n_points; ++i)
+    points.push_back(tf::random_vector<3>(0.f, 1.f));
+  std::cout << "Generated " << n_points << " random points in a unit cube."
+            << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  auto config = tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+    return tf::aabb_from(pt);
+  });
+  tf::mod_tree<int, float, 3> tree;
+  tree.build(points, config);
+
+  float r2 = 0.5f * 0.5f;
+  auto check_aabbs = [r2](const auto &aabb0, const auto &aabb1) {
+    return tf::distance2(aabb0, aabb1) <= r2;
+  };
+  // every pair of points in two boxes is within r,
+  // when the boxes are within r at their farthest points
+  auto contains_aabbs = [r2](const auto &aabb0, const auto &aabb1) {
+    return tf::maximal_distance2(aabb0, aabb1) <= r2;
+  };
+  auto primitive_check = [&points, r2](int id0, int id1) {
+    return (points[id0] - points[id1]).length2() <= r2;
+  };
+
+  auto brute_force_self = [&] {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+      for (std::size_t j = i + 1; j < points.size(); ++j)
+        count += primitive_check(i, j);
+    return count;
+  };
+  auto brute_force_dual = [&] {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+      for (std::size_t j = 0; j < points.size(); ++j)
+        count += primitive_check(i, j);
+    return count;
+  };
+
+  bool all_equal = true;
+  auto report = [&all_equal](const char *name, std::size_t plain,
+                             std::size_t bulk, std::size_t brute) {
+    std::cout << name << " pairs within radius 0.5:" << std::endl;
+    std::cout << "  count      : " << plain << std::endl;
+    std::cout << "  bulk count : " << bulk << std::endl;
+    std::cout << "  brute force: " << brute << std::endl;
+    all_equal &= plain == brute && bulk == brute;
+  };
+
+  auto report_all = [&] {
+    report("Self",
+           tf::search_self_count(tree, check_aabbs, primitive_check),
+           tf::search_self_count(tree, check_aabbs, contains_aabbs,
+                                 primitive_check),
+           brute_force_self());
+    report("Dual",
+           tf::search_count(tree, tree, check_aabbs, primitive_check),
+           tf::search_count(tree, tree, check_aabbs, contains_aabbs,
+                            primitive_check),
+           brute_force_dual());
+  };
+
+  report_all();
+  std::cout << "---------------------------------" << std::endl;
+
+  std::cout << "Move half of the points, and update the tree." << std::endl;
+  std::cout << "The moved ids are removed from the leaves of the main tree,"
+            << std::endl;
+  std::cout << "and inserted into the delta tree." << std::endl;
+  std::vector<int> moved_ids;
+  for (std::size_t i = 0; i < n_points / 2; ++i) {
+    points[i] += tf::random_vector<3>(-0.5f, 0.5f);
+    moved_ids.push_back(i);
+  }
+  tree.update(points, moved_ids,
+              [n = int(n_points / 2)](int id) { return id >= n; }, config);
+  std::cout << "---------------------------------" << std::endl;
+
+  report_all();
+  std::cout << "---------------------------------" << std::endl;
+  std::cout << (all_equal ? "All counts agree." : "Counts differ!")
+            << std::endl;
+  return all_equal ? 0 : 1;
+}
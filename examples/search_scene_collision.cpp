@@ -0,0 +1,92 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/random.hpp"
+#include "trueform/random_transformation.hpp"
+#include "trueform/scene_tree.hpp"
+#include "trueform/search_self_scene.hpp"
+#include "trueform/transformed_tree.hpp"
+#include "trueform/tree.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  tf::tree<int, float, 3> tree;
+  tree.build(tf::strategy::floyd_rivest, points,
+             tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+               return tf::aabb_from(pt);
+             }));
+  std::cout << "Build point tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // scatter instances of the point cloud in a box, so
+  // that neighbouring instances partially overlap
+  auto size = tree.nodes().front().aabb.diagonal().length();
+  const int n_instances = 200;
+  auto random_pose = [size] {
+    return tf::random_transformation<float>(
+        tf::make_vector(std::array<float, 3>{tf::random<float>(0, 4 * size),
+                                             tf::random<float>(0, 4 * size),
+                                             tf::random<float>(0, 4 * size)}));
+  };
+  std::vector<tf::transformed_tree<int, float, 3>> instances;
+  for (int i = 0; i < n_instances; ++i)
+    instances.push_back(tf::make_transformed_tree(tree, random_pose()));
+
+  tf::scene_tree<int, float, 3> scene;
+  scene.build(instances);
+  std::cout << "Build scene of " << n_instances
+            << " instances, sharing one tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // in every frame, a few instances are moved. Only their world
+  // boxes are updated in the top level, the point tree is untouched
+  auto epsilon = size / 1000;
+  for (int frame = 0; frame < 10; ++frame) {
+    std::vector<int> moved_ids;
+    std::vector<tf::transformation<float, 3>> poses;
+    for (int i = 0; i < 5; ++i) {
+      moved_ids.push_back((frame * 5 + i) % n_instances);
+      poses.push_back(random_pose());
+    }
+    auto start = std::chrono::steady_clock::now();
+    scene.update(moved_ids, poses);
+    auto update_done = std::chrono::steady_clock::now();
+
+    std::atomic<int> n_contacts{0};
+    tf::search_self(
+        scene, epsilon,
+        [&points = points, &n_contacts, epsilon](
+            int, int, int id0, int id1, const auto &relative) {
+          if ((points[id0] - relative.transform_point(points[id1]))
+                  .length2() < epsilon * epsilon)
+            n_contacts.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        },
+        [] { return false; });
+    auto search_done = std::chrono::steady_clock::now();
+
+    std::cout << "Frame " << frame << ": " << n_contacts.load()
+              << " contacts, update "
+              << std::chrono::duration<double, std::milli>(update_done -
+                                                           start)
+                     .count()
+              << " ms, search "
+              << std::chrono::duration<double, std::milli>(search_done -
+                                                           update_done)
+                     .count()
+              << " ms" << std::endl;
+  }
+}
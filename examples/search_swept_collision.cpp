@@ -0,0 +1,99 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/closest_point_on_triangle.hpp"
+#include "trueform/earliest_contact.hpp"
+#include "trueform/indirect_range.hpp"
+#include "trueform/motion.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/search.hpp"
+#include "trueform/transformation.hpp"
+#include "trueform/tree.hpp"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> mesh_tree;
+  mesh_tree.build(
+      triangles, tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+        return tf::aabb_union(
+            tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                           points[t[1]]),
+            points[t[2]]);
+      }));
+  std::cout << "Build triangle tree." << std::endl;
+
+  // a small tool, made of points around the origin
+  auto size = mesh_tree.nodes().front().aabb.diagonal().length();
+  std::vector<tf::vector<float, 3>> tool;
+  for (int i = 0; i < 100; ++i)
+    tool.push_back(tf::random_vector<float, 3>() * (size / 100));
+  tf::tree<int, float, 3> tool_tree;
+  tool_tree.build(tool,
+                  tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+                    return tf::aabb_from(pt);
+                  }));
+  std::cout << "Build tool tree." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  // in one time step, the tool moves across the whole mesh. Both end
+  // poses are outside of it, so a search at the end poses misses it
+  auto center = mesh_tree.nodes().front().aabb.center();
+  auto offset = tf::make_vector(std::array<float, 3>{size, 0, 0});
+  auto tool_motion = tf::make_motion(
+      tf::make_transformation_from_translation(center - offset),
+      tf::make_transformation_from_translation(center + offset));
+  auto mesh_motion =
+      tf::make_motion(tf::make_identity_transformation<float, 3>());
+  auto epsilon = size / 1000;
+
+  std::atomic<int> n_candidates{0};
+  tf::search(
+      tool_tree, tool_motion, mesh_tree, mesh_motion, epsilon,
+      [&n_candidates](int, int, const tf::time_interval<float> &) {
+        n_candidates.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      },
+      [] { return false; });
+  std::cout << "Point-triangle pairs that may collide during the step: "
+            << n_candidates.load() << std::endl;
+
+  // conservative advancement finds the time of first contact
+  auto contact = tf::earliest_contact(
+      tool_tree, tool_motion, mesh_tree, mesh_motion,
+      [&tool, &points = points, &triangles = triangles](
+          int point_id, int triangle_id,
+          const tf::transformation<float, 3> &tool_pose,
+          const tf::transformation<float, 3> &mesh_pose) {
+        auto pt = tool_pose.transform_point(tool[point_id]);
+        const auto &t = triangles[triangle_id];
+        std::array<tf::vector<float, 3>, 3> triangle{
+            mesh_pose.transform_point(points[t[0]]),
+            mesh_pose.transform_point(points[t[1]]),
+            mesh_pose.transform_point(points[t[2]])};
+        auto cpt = tf::closest_point_on_triangle(triangle, pt);
+        return tf::make_closest_point_pair((cpt - pt).length2(), pt, cpt);
+      },
+      epsilon);
+  if (contact) {
+    auto [point_id, triangle_id] = contact.points.elements;
+    std::cout << "First contact at time " << contact.time << ", of tool point "
+              << point_id << " with triangle " << triangle_id << std::endl;
+  } else if (contact.lower_bound <= 1)
+    std::cout << "No contact within the iteration limit, none before time "
+              << contact.lower_bound << std::endl;
+  else
+    std::cout << "No contact during the step." << std::endl;
+}
@@ -4,6 +4,7 @@
 #include "trueform/random.hpp"
 #include "trueform/random_vector.hpp"
 #include "trueform/search_self.hpp"
+#include "trueform/search_self_collect.hpp"
 #include "trueform/tree.hpp"
 #include <iostream>
 #include <string>
@@ -74,4 +75,23 @@ int main(int argc, char *argv[]) {
             << " point pairs within epsilon of eachother" << std::endl;
   for (auto id : ids)
     std::cout << "  " << id.first << ", " << id.second << std::endl;
+
+  std::cout << "---------------------------------" << std::endl;
+  // the same can be collected without synchronization. Pairs are
+  // pushed into thread-local buffers, concatenated at the end.
+  // tf::strategy::sorted makes the result deterministic
+  auto pairs = tf::search_self_collect(
+      tf::strategy::sorted, tree,
+      [&](const auto &aabb0, const auto &aabb1) {
+        return tf::intersects(aabb0, aabb1, epsilon);
+      },
+      [&duplicated_points = duplicated_points,
+       epsilon2 = epsilon * epsilon](auto id0, auto id1) {
+        return (duplicated_points[id0] - duplicated_points[id1]).length2() <
+               epsilon2;
+      });
+  std::cout << "Collected " << pairs.size()
+            << " point pairs within epsilon of eachother" << std::endl;
+  for (auto [id0, id1] : pairs)
+    std::cout << "  " << id0 << ", " << id1 << std::endl;
 }
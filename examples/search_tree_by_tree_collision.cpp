@@ -1,11 +1,14 @@
 #include "./util/read_mesh.hpp"
-#include "trueform/intersects.hpp"
+#include "trueform/pair_cache.hpp"
 #include "trueform/random.hpp"
 #include "trueform/random_transformation.hpp"
+#include "trueform/random_vector.hpp"
 #include "trueform/search.hpp"
 #include "trueform/transformation.hpp"
 #include "trueform/transformed.hpp"
+#include "trueform/transformed_tree.hpp"
 #include "trueform/tree.hpp"
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <string>
@@ -28,11 +31,11 @@ int main(int argc, char *argv[]) {
   auto id1 = tf::random<int>(0, points.size() - 1);
   auto pt1 = points[id1];
 
+  auto config = tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
+    return tf::aabb_from(pt);
+  });
   tf::tree<int, float, 3> tree;
-  tree.build(tf::strategy::floyd_rivest, points,
-             tf::config_tree(4, 4, [](const tf::vector<float, 3> &pt) {
-               return tf::aabb_from(pt);
-             }));
+  tree.build(tf::strategy::floyd_rivest, points, config);
   std::cout << "Build point tree." << std::endl;
   std::cout << "---------------------------------" << std::endl;
 
@@ -54,15 +57,14 @@ int main(int argc, char *argv[]) {
                       tf::random_transformation<float>(pt0));
 
   std::atomic<bool> are_colliding{false};
-  // we may use the same tree, as we will simply
-  // apply the transformation to the aabbs and primitives.
+  // we may use the same tree. Node boxes of the second tree are tested
+  // as oriented boxes under the transformation, which is tighter than
+  // testing against tf::transformed(aabb1, transformation). The
+  // transformation is passed through to the primitive callback.
   bool collision_test = tf::search(
-      tree, tree,
-      [&](const auto &aabb0, const auto &aabb1) { // transform the aabb
-        return tf::intersects(aabb0, tf::transformed(aabb1, transformation),
-                              std::numeric_limits<float>::epsilon());
-      },
-      [&points = points, &transformation, &are_colliding](auto id0, auto id1) {
+      tree, tree, transformation, std::numeric_limits<float>::epsilon(),
+      [&points = points, &are_colliding](auto id0, auto id1,
+                                         const auto &transformation) {
         if ((points[id0] - transformation.transform_point(points[id1]))
                 .length2() < std::numeric_limits<float>::epsilon()) {
           are_colliding.store(true);
@@ -74,4 +76,39 @@ int main(int argc, char *argv[]) {
 
   std::cout << "Are clouds colliding: " << (collision_test ? "yes" : "no")
             << std::endl;
+
+  std::cout << "---------------------------------" << std::endl;
+
+  // over several frames, a small patch of the cloud deforms, and the tree
+  // is refit. The pair cache keeps the node pairs where the last search
+  // stopped, and each frame only retests those below nodes whose boxes
+  // changed. The relative pose of the two copies is kept, as a change of
+  // it would change every node pair
+  tf::pair_cache<int, float, 3> cache;
+  auto size = tree.nodes().front().aabb.diagonal().length();
+  auto view0 = tf::make_transformed_tree(
+      tree, tf::make_transformation_from_translation(
+                tf::make_vector(std::array<float, 3>{0, 0, 0})));
+  auto view1 = tf::make_transformed_tree(tree, transformation);
+  for (int frame = 0; frame < 5; ++frame) {
+    auto patch_size = std::min(int(points.size()), 100);
+    auto first = tf::random<int>(0, points.size() - patch_size);
+    for (int i = first; i < first + patch_size; ++i)
+      points[tree.ids()[i]] += tf::random_vector<3>(-1.f, 1.f) * size / 1000;
+    tree.refit(points, config);
+    std::atomic<int> n_contacts{0};
+    tf::search(
+        cache, view0, view1, size / 1000,
+        [&points = points, &n_contacts, size](auto id0, auto id1,
+                                              const auto &relative) {
+          if ((points[id0] - relative.transform_point(points[id1])).length() <
+              size / 1000)
+            n_contacts.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        },
+        [] { return false; });
+    std::cout << "Frame " << frame << ": " << n_contacts.load()
+              << " contacts, " << cache.size() << " cached node pairs"
+              << std::endl;
+  }
 }
@@ -0,0 +1,75 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/dot.hpp"
+#include "trueform/mesh_pseudonormals.hpp"
+#include "trueform/random.hpp"
+#include "trueform/random_vector.hpp"
+#include "trueform/signed_distance.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> tree;
+  tree.build(triangles,
+             tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+               return tf::aabb_union(
+                   tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                  points[t[1]]),
+                   points[t[2]]);
+             }));
+  tf::tick();
+  tf::mesh_pseudonormals<int, float> normals;
+  normals.build(triangles, points);
+  auto build_time = tf::tock();
+  std::cout << "Build tree and pseudonormals (" << build_time
+            << " ms for the pseudonormals)." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  const int n_queries = 100000;
+  std::cout << "Computing signed distances of " << n_queries
+            << " points near the vertices of the mesh." << std::endl;
+  auto extent = tree.nodes().front().aabb.diagonal().length();
+  std::vector<tf::vector<float, 3>> queries;
+  queries.reserve(n_queries);
+  for (int i = 0; i < n_queries; ++i)
+    queries.push_back(points[tf::random<int>(0, points.size() - 1)] +
+                      tf::random_vector<3>(-1.f, 1.f) * (extent * 1e-3f));
+  tf::tick();
+  auto distances =
+      tf::signed_distances(tree, triangles, points, normals, queries);
+  auto time = tf::tock();
+
+  int n_inside = 0, n_disagree = 0;
+  int n_features[3] = {0, 0, 0};
+  for (int i = 0; i < n_queries; ++i) {
+    const auto &result = distances[i];
+    n_inside += result.distance < 0;
+    ++n_features[int(result.feature)];
+    // the sign that the normal of the closest face alone would give
+    auto face_sign = tf::dot(queries[i] - result.point,
+                             normals.face_normals()[result.element]) < 0;
+    n_disagree += face_sign != (result.distance < 0);
+  }
+  std::cout << "  computed in " << time << " ms" << std::endl;
+  std::cout << "  inside: " << n_inside << std::endl;
+  std::cout << "  closest to a vertex: " << n_features[0]
+            << ", an edge: " << n_features[1]
+            << ", a face: " << n_features[2] << std::endl;
+  std::cout << "  queries where the face normal gives the wrong sign: "
+            << n_disagree << std::endl;
+}
@@ -0,0 +1,79 @@
+#include "./util/read_mesh.hpp"
+#include "trueform/aabb_union.hpp"
+#include "trueform/fast_winding_number.hpp"
+#include "trueform/random.hpp"
+#include "trueform/tick_tock.hpp"
+#include "trueform/tree.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: program <input.obj>\n";
+    return 1;
+  }
+
+  std::cout << "Reading file: " << argv[1] << std::endl;
+  auto [points, triangles] = tf::examples::read_mesh(argv[1]);
+  std::cout << "  number of triangles: " << triangles.size() << std::endl;
+  std::cout << "  number of points   : " << points.size() << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  using triangle_t = std::array<int, 3>;
+  tf::tree<int, float, 3> tree;
+  tree.build(triangles,
+             tf::config_tree(4, 4, [&points = points](const triangle_t &t) {
+               return tf::aabb_union(
+                   tf::aabb_union(tf::make_aabb(points[t[0]], points[t[0]]),
+                                  points[t[1]]),
+                   points[t[2]]);
+             }));
+  tf::tick();
+  tf::fast_winding_number<int, float> winding;
+  winding.build(tree, triangles, points);
+  auto build_time = tf::tock();
+  std::cout << "Build tree and winding number expansions ("
+            << build_time << " ms for the expansions)." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  const int n = 100;
+  std::cout << "Classifying the centers of a " << n << "^3 voxel grid over "
+            << "the bounding box of the mesh." << std::endl;
+  auto box = tree.nodes().front().aabb;
+  auto diagonal = box.diagonal();
+  std::vector<tf::vector<float, 3>> voxels;
+  voxels.reserve(n * n * n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      for (int k = 0; k < n; ++k)
+        voxels.push_back(tf::make_vector<float, 3>(
+            {box.min[0] + diagonal[0] * (i + 0.5f) / n,
+             box.min[1] + diagonal[1] * (j + 0.5f) / n,
+             box.min[2] + diagonal[2] * (k + 0.5f) / n}));
+  tf::tick();
+  auto numbers = tf::winding_numbers(winding, triangles, points, voxels);
+  auto time = tf::tock();
+  auto inside = std::count_if(numbers.begin(), numbers.end(),
+                              [](float w) { return w > 0.5f; });
+  std::cout << "  " << inside << " of " << voxels.size()
+            << " voxels are inside, in " << time << " ms." << std::endl;
+  std::cout << "---------------------------------" << std::endl;
+
+  const int n_checks = 100;
+  std::cout << "Comparing to exact winding numbers at " << n_checks
+            << " random voxels." << std::endl;
+  float max_error = 0;
+  int n_misclassified = 0;
+  for (int c = 0; c < n_checks; ++c) {
+    auto v = tf::random<int>(0, voxels.size() - 1);
+    // with a very large accuracy, every triangle is evaluated exactly
+    auto exact =
+        tf::winding_number(winding, triangles, points, voxels[v], 1e6f);
+    max_error = std::max(max_error, std::abs(exact - numbers[v]));
+    n_misclassified += (exact > 0.5f) != (numbers[v] > 0.5f);
+  }
+  std::cout << "  max error: " << max_error << std::endl;
+  std::cout << "  misclassified: " << n_misclassified << std::endl;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include <cstddef>
+#include <limits>
+
+namespace tf {
+
+/// @brief Parameters of an approximate (1+ε) nearness query.
+///
+/// Passed to @ref tf::nearness_search to trade exactness for speed. Nodes are
+/// pruned when their AABB metric exceeds `result.metric() / (1 + epsilon)^2`,
+/// so the distance of every reported primitive is within a factor of
+/// `1 + epsilon` of the true distance (for squared distance metrics).
+///
+/// Optionally, the number of evaluated primitives is capped by
+/// `max_evaluations`. Once the cap is reached, the traversal stops after the
+/// current leaf and the best result found so far is returned, without the
+/// `1 + epsilon` guarantee.
+///
+/// Use `tf::make_approximation` to create an instance.
+///
+/// @tparam RealT The scalar coordinate type.
+template <typename RealT> struct approximation {
+  RealT epsilon{0};
+  std::size_t max_evaluations{std::numeric_limits<std::size_t>::max()};
+};
+
+/// @brief Create parameters of an approximate (1+ε) nearness query.
+///
+/// @param epsilon The allowed relative error of the distance.
+/// @return A `tf::approximation` instance.
+template <typename RealT>
+auto make_approximation(RealT epsilon) -> approximation<RealT> {
+  return approximation<RealT>{epsilon};
+}
+
+/// @brief Create parameters of an approximate (1+ε) nearness query.
+///
+/// @param epsilon The allowed relative error of the distance.
+/// @param max_evaluations The maximal number of evaluated primitives.
+/// @return A `tf::approximation` instance.
+template <typename RealT>
+auto make_approximation(RealT epsilon, std::size_t max_evaluations)
+    -> approximation<RealT> {
+  return approximation<RealT>{epsilon, max_evaluations};
+}
+
+} // namespace tf
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./dot.hpp"
+#include "./vector.hpp"
+#include "./vector_view.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace tf {
+
+/// @brief The feature of a triangle on which a closest point lies.
+enum class triangle_feature : std::int8_t { vertex, edge, face };
+
+/// @brief A closest point on a triangle, with the feature it lies on.
+///
+/// For `tf::triangle_feature::vertex`, `id` is the local vertex `i`. For
+/// `tf::triangle_feature::edge`, `id` is the local edge `i`, from vertex `i`
+/// to vertex `(i + 1) % 3`. For `tf::triangle_feature::face`, `id` is 0.
+///
+/// @tparam T The scalar coordinate type.
+template <typename T> struct closest_feature {
+  tf::vector<T, 3> point;
+  tf::triangle_feature feature;
+  std::int8_t id;
+};
+
+/// @brief Compute the closest point on a triangle and the feature it lies
+/// on.
+///
+/// Follows the Voronoi regions of @ref tf::closest_point_on_triangle, and
+/// additionally reports the region: one of the vertices, one of the edges
+/// or the interior of the face.
+///
+/// @param triangle A range of three points.
+/// @param point The query point.
+///
+/// @return tf::closest_feature<T>.
+template <typename Range, typename T>
+auto closest_feature_on_triangle(const Range &triangle,
+                                 const tf::vector_view<T, 3> &point)
+    -> tf::closest_feature<std::remove_const_t<T>> {
+  auto ab = triangle[1] - triangle[0];
+  auto ac = triangle[2] - triangle[0];
+  auto ap = point - triangle[0];
+  auto d1 = tf::dot(ab, ap);
+  auto d2 = tf::dot(ac, ap);
+  if (d1 <= 0 && d2 <= 0)
+    return {triangle[0], tf::triangle_feature::vertex, 0};
+  auto bp = point - triangle[1];
+  auto d3 = tf::dot(ab, bp);
+  auto d4 = tf::dot(ac, bp);
+  if (d3 >= 0 && d4 <= d3)
+    return {triangle[1], tf::triangle_feature::vertex, 1};
+  auto vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    auto v = d1 / (d1 - d3);
+    return {triangle[0] + v * ab, tf::triangle_feature::edge, 0};
+  }
+  auto cp = point - triangle[2];
+  auto d5 = tf::dot(ab, cp);
+  auto d6 = tf::dot(ac, cp);
+  if (d6 >= 0 && d5 <= d6)
+    return {triangle[2], tf::triangle_feature::vertex, 2};
+  auto vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    auto w = d2 / (d2 - d6);
+    return {triangle[0] + w * ac, tf::triangle_feature::edge, 2};
+  }
+  auto va = d3 * d6 - d5 * d4;
+  if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+    auto w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    return {triangle[1] + w * (triangle[2] - triangle[1]),
+            tf::triangle_feature::edge, 1};
+  }
+  auto denom = 1 / (va + vb + vc);
+  auto v = vb * denom;
+  auto w = vc * denom;
+  return {triangle[0] + ab * v + ac * w, tf::triangle_feature::face, 0};
+}
+
+/// @brief Compute the closest point on a triangle and the feature it lies
+/// on.
+///
+/// @param triangle A range of three points.
+/// @param point The query point.
+///
+/// @return tf::closest_feature<T>.
+template <typename Range, typename T>
+auto closest_feature_on_triangle(const Range &triangle,
+                                 const tf::vector<T, 3> &point)
+    -> tf::closest_feature<T> {
+  return closest_feature_on_triangle(triangle,
+                                     tf::make_vector_view<3>(point.begin()));
+}
+} // namespace tf
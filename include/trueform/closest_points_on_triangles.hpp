@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./vector.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+namespace tf {
+
+/// @brief A block of `Lanes` 3D points in structure-of-arrays layout.
+///
+/// `lanes[d][i]` is coordinate `d` of point `i`. Used as the input and output
+/// of @ref tf::closest_points_on_triangles.
+///
+/// @tparam T The scalar coordinate type.
+/// @tparam Lanes The number of points in the block (typically 4 or 8).
+template <typename T, std::size_t Lanes>
+using point_lanes = std::array<std::array<T, Lanes>, 3>;
+
+/// @brief Set lane `i` of a block of points.
+template <typename T, std::size_t Lanes, typename Point>
+auto set_lane(tf::point_lanes<T, Lanes> &lanes, std::size_t i,
+              const Point &point) -> void {
+  lanes[0][i] = point[0];
+  lanes[1][i] = point[1];
+  lanes[2][i] = point[2];
+}
+
+/// @brief Get lane `i` of a block of points.
+template <typename T, std::size_t Lanes>
+auto get_lane(const tf::point_lanes<T, Lanes> &lanes, std::size_t i)
+    -> tf::vector<T, 3> {
+  return tf::make_vector<T, 3>({lanes[0][i], lanes[1][i], lanes[2][i]});
+}
+
+/// @brief Set all lanes of a block of points to the same point.
+template <typename T, std::size_t Lanes, typename Point>
+auto broadcast_lanes(tf::point_lanes<T, Lanes> &lanes, const Point &point)
+    -> void {
+  for (std::size_t d = 0; d < 3; ++d)
+    lanes[d].fill(point[d]);
+}
+
+namespace implementation {
+#if defined(__GNUC__)
+// a native vector of `Lanes` elements, compiled to SIMD instructions
+template <typename T, std::size_t Lanes> struct lane_vector {
+  typedef T type __attribute__((vector_size(sizeof(T) * Lanes)));
+};
+#endif
+
+template <typename V, typename T> auto load_lanes(V &v, const T *p) -> void {
+  std::memcpy(&v, p, sizeof(V));
+}
+
+template <typename V, typename T> auto store_lanes(T *p, const V &v) -> void {
+  std::memcpy(p, &v, sizeof(V));
+}
+
+// Evaluates the lanes starting at `i`, as many as fit into `V`. With a
+// vector `V`, comparisons produce masks and `?:` selects per lane. With a
+// scalar `V`, the same code evaluates one lane, without branches.
+template <typename V, typename T, std::size_t Lanes>
+auto closest_points_on_triangles(const tf::point_lanes<T, Lanes> &a,
+                                 const tf::point_lanes<T, Lanes> &b,
+                                 const tf::point_lanes<T, Lanes> &c,
+                                 const tf::point_lanes<T, Lanes> &points,
+                                 tf::point_lanes<T, Lanes> &closest,
+                                 std::array<T, Lanes> &distances2,
+                                 std::size_t i) -> void {
+  V a0, a1, a2, b0, b1, b2, c0, c1, c2, p0, p1, p2;
+  load_lanes(a0, &a[0][i]);
+  load_lanes(a1, &a[1][i]);
+  load_lanes(a2, &a[2][i]);
+  load_lanes(b0, &b[0][i]);
+  load_lanes(b1, &b[1][i]);
+  load_lanes(b2, &b[2][i]);
+  load_lanes(c0, &c[0][i]);
+  load_lanes(c1, &c[1][i]);
+  load_lanes(c2, &c[2][i]);
+  load_lanes(p0, &points[0][i]);
+  load_lanes(p1, &points[1][i]);
+  load_lanes(p2, &points[2][i]);
+  V ab0 = b0 - a0, ab1 = b1 - a1, ab2 = b2 - a2;
+  V ac0 = c0 - a0, ac1 = c1 - a1, ac2 = c2 - a2;
+  V ap0 = p0 - a0, ap1 = p1 - a1, ap2 = p2 - a2;
+  V bp0 = p0 - b0, bp1 = p1 - b1, bp2 = p2 - b2;
+  V cp0 = p0 - c0, cp1 = p1 - c1, cp2 = p2 - c2;
+  V d1 = ab0 * ap0 + ab1 * ap1 + ab2 * ap2;
+  V d2 = ac0 * ap0 + ac1 * ap1 + ac2 * ap2;
+  V d3 = ab0 * bp0 + ab1 * bp1 + ab2 * bp2;
+  V d4 = ac0 * bp0 + ac1 * bp1 + ac2 * bp2;
+  V d5 = ab0 * cp0 + ab1 * cp1 + ab2 * cp2;
+  V d6 = ac0 * cp0 + ac1 * cp1 + ac2 * cp2;
+  V va = d3 * d6 - d5 * d4;
+  V vb = d5 * d2 - d1 * d6;
+  V vc = d1 * d4 - d3 * d2;
+  // all regions are evaluated, with guarded denominators, so
+  // that unselected regions do not produce infinities
+  V den_abc = va + vb + vc;
+  V den_bc = (d4 - d3) + (d5 - d6);
+  V den_ac = d2 - d6;
+  V den_ab = d1 - d3;
+  den_abc = den_abc == 0 ? T(1) : den_abc;
+  den_bc = den_bc == 0 ? T(1) : den_bc;
+  den_ac = den_ac == 0 ? T(1) : den_ac;
+  den_ab = den_ab == 0 ? T(1) : den_ab;
+  V v_abc = vb / den_abc;
+  V w_abc = vc / den_abc;
+  V w_bc = (d4 - d3) / den_bc;
+  V w_ac = d2 / den_ac;
+  V v_ab = d1 / den_ab;
+  auto in_bc = (va <= 0) & ((d4 - d3) >= 0) & ((d5 - d6) >= 0);
+  auto in_ac = (vb <= 0) & (d2 >= 0) & (d6 <= 0);
+  auto in_c = (d6 >= 0) & (d5 <= d6);
+  auto in_ab = (vc <= 0) & (d1 >= 0) & (d3 <= 0);
+  auto in_b = (d3 >= 0) & (d4 <= d3);
+  auto in_a = (d1 <= 0) & (d2 <= 0);
+  // the barycentric coordinates (v, w) of the interior are overridden by
+  // the regions in reverse order of precedence
+  V v = in_bc ? 1 - w_bc : v_abc;
+  V w = in_bc ? w_bc : w_abc;
+  v = in_ac ? T(0) : v;
+  w = in_ac ? w_ac : w;
+  v = in_c ? T(0) : v;
+  w = in_c ? T(1) : w;
+  v = in_ab ? v_ab : v;
+  w = in_ab ? T(0) : w;
+  v = in_b ? T(1) : v;
+  w = in_b ? T(0) : w;
+  v = in_a ? T(0) : v;
+  w = in_a ? T(0) : w;
+  V x = a0 + ab0 * v + ac0 * w;
+  V y = a1 + ab1 * v + ac1 * w;
+  V z = a2 + ab2 * v + ac2 * w;
+  store_lanes(&closest[0][i], x);
+  store_lanes(&closest[1][i], y);
+  store_lanes(&closest[2][i], z);
+  x -= p0;
+  y -= p1;
+  z -= p2;
+  V distance2 = x * x + y * y + z * z;
+  store_lanes(&distances2[i], distance2);
+}
+} // namespace implementation
+
+/// @brief Compute the closest points on `Lanes` triangles to `Lanes` points
+/// at once.
+///
+/// Lane `i` computes the closest point on the triangle `(a[i], b[i], c[i])`
+/// to `points[i]`, with the same Voronoi-region logic as
+/// @ref tf::closest_point_on_triangle. Instead of returning early, all
+/// regions are evaluated and the result is selected per lane, without
+/// branches. With GCC and Clang, a power-of-two number of lanes is
+/// evaluated with native vector types (SSE/AVX/NEON, as enabled by the
+/// target flags). Otherwise, the lanes are evaluated one by one.
+///
+/// To query many triangles with one point, or one triangle with many
+/// points, broadcast the shared input with @ref tf::broadcast_lanes.
+/// Unused lanes may hold any finite data.
+///
+/// @param a The first vertices of the triangles.
+/// @param b The second vertices of the triangles.
+/// @param c The third vertices of the triangles.
+/// @param points The query points.
+/// @param closest The closest points, written per lane.
+/// @param distances2 The squared distances from the query points to the
+/// closest points, written per lane.
+template <typename T, std::size_t Lanes>
+auto closest_points_on_triangles(const tf::point_lanes<T, Lanes> &a,
+                                 const tf::point_lanes<T, Lanes> &b,
+                                 const tf::point_lanes<T, Lanes> &c,
+                                 const tf::point_lanes<T, Lanes> &points,
+                                 tf::point_lanes<T, Lanes> &closest,
+                                 std::array<T, Lanes> &distances2) -> void {
+#if defined(__GNUC__)
+  if constexpr ((Lanes & (Lanes - 1)) == 0) {
+    using vector_t = typename implementation::lane_vector<T, Lanes>::type;
+    implementation::closest_points_on_triangles<vector_t>(
+        a, b, c, points, closest, distances2, 0);
+    return;
+  }
+#endif
+  for (std::size_t i = 0; i < Lanes; ++i)
+    implementation::closest_points_on_triangles<T>(a, b, c, points, closest,
+                                                   distances2, i);
+}
+
+} // namespace tf
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb_metrics.hpp"
+#include "./motion.hpp"
+#include "./nearness_search.hpp"
+#include "./time_interval.hpp"
+#include "./transformed.hpp"
+#include "./tree.hpp"
+#include "./tree_closest_point_pair.hpp"
+#include <cmath>
+#include <limits>
+
+namespace tf {
+
+/// @brief The earliest contact between two moving trees.
+///
+/// `time` is the time of contact within `[0, 1]`, and `points` the closest
+/// pair of primitives at that time. Without contact, `time` is
+/// `std::numeric_limits<RealT>::max()`.
+///
+/// `lower_bound` is a time before which there is no contact. It equals `time`
+/// on contact. When the search ran out of iterations, no contact was found
+/// and `time` is left at no contact, but `lower_bound` is the time that
+/// advancement reached, which may be within `[0, 1]`.
+///
+/// @tparam Index The type used for primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+/// @tparam Dims The spatial dimension.
+template <typename Index, typename RealT, std::size_t Dims>
+struct tree_earliest_contact {
+  RealT time = std::numeric_limits<RealT>::max();
+  RealT lower_bound = std::numeric_limits<RealT>::max();
+  tf::tree_closest_point_pair<Index, RealT, Dims> points;
+
+  operator bool() const { return time <= 1; }
+};
+
+/// @brief Find the earliest time at which two moving trees come within
+/// epsilon of each other, by conservative advancement.
+///
+/// Each tree moves over `[0, 1]` as given by its @ref tf::motion. Starting
+/// at the first time at which the moving root boxes overlap, the distance
+/// `d` between the trees is computed with @ref tf::nearness_search, and time
+/// is advanced by `(d - epsilon / 2) / speed`. `speed` bounds the relative
+/// velocity of any pair of points, so no contact is stepped over, regardless
+/// of how thin the geometry is.
+///
+/// If `max_iterations` is exhausted before contact, no contact is reported.
+/// `lower_bound` then holds a conservative lower bound on the time of
+/// contact, and `points` the closest pair at that time.
+///
+/// @param tree0 The first spatial tree.
+/// @param motion0 The motion of the first tree.
+/// @param tree1 The second spatial tree.
+/// @param motion1 The motion of the second tree.
+/// @param closest_points_f A function that evaluates the closest points of a
+/// pair of primitives, at the given (affine) poses, in the world frame.
+///                         Signature: `(Index id0, Index id1, const
+///                         tf::transformation<RealT, N>& pose0, const
+///                         tf::transformation<RealT, N>& pose1) ->
+///                         tf::closest_point_pair<RealT, N>`
+/// @param epsilon The contact distance. Must be positive.
+/// @param max_iterations The maximal number of advancement steps.
+///
+/// @return tf::tree_earliest_contact<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto earliest_contact(const tf::tree<Index, RealT, N> &tree0,
+                      const tf::motion<RealT, N> &motion0,
+                      const tf::tree<Index, RealT, N> &tree1,
+                      const tf::motion<RealT, N> &motion1,
+                      const F &closest_points_f, RealT epsilon,
+                      int max_iterations = 64)
+    -> tf::tree_earliest_contact<Index, RealT, N> {
+  tf::tree_earliest_contact<Index, RealT, N> out;
+  if (!tree0.nodes().size() || !tree1.nodes().size())
+    return out;
+  const auto &root0 = tree0.nodes()[0].aabb;
+  const auto &root1 = tree1.nodes()[0].aabb;
+  auto interval = tf::impact_interval(
+      tf::transformed(root0, motion0.from()),
+      tf::transformed(root0, motion0.to()),
+      tf::transformed(root1, motion1.from()),
+      tf::transformed(root1, motion1.to()), epsilon);
+  if (!interval)
+    return out;
+  auto speed =
+      motion0.max_displacement(root0) + motion1.max_displacement(root1);
+  auto time = interval.min;
+  for (int i = 0; i < max_iterations; ++i) {
+    auto pose0 = motion0.at(time);
+    auto pose1 = motion1.at(time);
+    auto closest = tf::nearness_search(
+        tree0, tree1,
+        [&pose0, &pose1](const tf::aabb<RealT, N> &aabb0,
+                         const tf::aabb<RealT, N> &aabb1) {
+          return tf::make_aabb_metrics(tf::transformed(aabb0, pose0),
+                                       tf::transformed(aabb1, pose1));
+        },
+        [&closest_points_f, &pose0, &pose1](Index id0, Index id1) {
+          return closest_points_f(id0, id1, pose0, pose1);
+        });
+    auto distance = std::sqrt(closest.metric());
+    if (distance <= epsilon) {
+      out.time = time;
+      out.lower_bound = time;
+      out.points = closest;
+      return out;
+    }
+    // separated, and not moving relative to each other
+    if (speed <= 0)
+      return out;
+    time += (distance - epsilon / 2) / speed;
+    // past the overlap of the root boxes
+    if (time > interval.max)
+      return out;
+    out.points = closest;
+  }
+  out.lower_bound = time;
+  return out;
+}
+
+} // namespace tf
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./dot.hpp"
+#include "./implementation/adaptive_split.hpp"
+#include "./small_buffer.hpp"
+#include "./tree.hpp"
+#include "./vector.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace tf::implementation {
+
+// The far-field expansion of the winding number of the triangles below a
+// node, around their area-weighted centroid (Barill et al., "Fast Winding
+// Numbers for Soups and Clouds"). `dipole` is the sum of the area vectors
+// A_t of the triangles, `quadrupole` the sum of A_t ⊗ (c_t - center), where
+// c_t is the centroid of a triangle, stored row-major. `radius` bounds the
+// distance from the center to the triangles.
+template <typename RealT> struct winding_moments {
+  tf::vector<RealT, 3> center;
+  tf::vector<RealT, 3> dipole;
+  std::array<RealT, 9> quadrupole;
+  RealT area;
+  RealT radius;
+};
+
+template <typename RealT, typename Point>
+auto to_winding_point(const Point &point) -> tf::vector<RealT, 3> {
+  return tf::make_vector<RealT, 3>(
+      {RealT(point[0]), RealT(point[1]), RealT(point[2])});
+}
+
+template <typename RealT>
+auto winding_cross(const tf::vector<RealT, 3> &a, const tf::vector<RealT, 3> &b)
+    -> tf::vector<RealT, 3> {
+  return tf::make_vector<RealT, 3>({a[1] * b[2] - a[2] * b[1],
+                                    a[2] * b[0] - a[0] * b[2],
+                                    a[0] * b[1] - a[1] * b[0]});
+}
+
+template <typename RealT>
+auto add_outer_product(std::array<RealT, 9> &m, const tf::vector<RealT, 3> &a,
+                       const tf::vector<RealT, 3> &b) -> void {
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      m[3 * i + j] += a[i] * b[j];
+}
+
+template <typename RealT, typename Range0, typename Range1, typename Range2>
+auto leaf_winding_moments(const Range0 &ids, const Range1 &triangles,
+                          const Range2 &points) -> winding_moments<RealT> {
+  winding_moments<RealT> out;
+  out.center = tf::make_vector<RealT, 3>({0, 0, 0});
+  out.dipole = out.center;
+  out.quadrupole.fill(0);
+  out.area = 0;
+  tf::vector<RealT, 3> mean = out.center;
+  for (auto id : ids) {
+    const auto &t = triangles[id];
+    auto a = to_winding_point<RealT>(points[t[0]]);
+    auto b = to_winding_point<RealT>(points[t[1]]);
+    auto c = to_winding_point<RealT>(points[t[2]]);
+    auto area_vector = winding_cross(b - a, c - a) * RealT(0.5);
+    auto area = area_vector.length();
+    auto centroid = (a + b + c) * RealT(1. / 3);
+    out.dipole += area_vector;
+    out.center += centroid * area;
+    out.area += area;
+    mean += centroid;
+  }
+  out.center = out.area > 0 ? out.center * (1 / out.area)
+                            : mean * (RealT(1) / RealT(ids.size()));
+  out.radius = 0;
+  for (auto id : ids) {
+    const auto &t = triangles[id];
+    auto a = to_winding_point<RealT>(points[t[0]]);
+    auto b = to_winding_point<RealT>(points[t[1]]);
+    auto c = to_winding_point<RealT>(points[t[2]]);
+    add_outer_product(out.quadrupole, winding_cross(b - a, c - a) * RealT(0.5),
+                      (a + b + c) * RealT(1. / 3) - out.center);
+    out.radius = std::max({out.radius, (a - out.center).length2(),
+                           (b - out.center).length2(),
+                           (c - out.center).length2()});
+  }
+  out.radius = std::sqrt(out.radius);
+  return out;
+}
+
+// Merges the moments of the children into the moments of their parent.
+// The quadrupole is shifted to the new center, and the radius bounds the
+// spheres of the children.
+template <typename RealT, typename Range>
+auto inner_winding_moments(const Range &children) -> winding_moments<RealT> {
+  winding_moments<RealT> out;
+  out.center = tf::make_vector<RealT, 3>({0, 0, 0});
+  out.dipole = out.center;
+  out.quadrupole.fill(0);
+  out.area = 0;
+  tf::vector<RealT, 3> mean = out.center;
+  for (const auto &child : children) {
+    out.dipole += child.dipole;
+    out.center += child.center * child.area;
+    out.area += child.area;
+    mean += child.center;
+  }
+  out.center = out.area > 0 ? out.center * (1 / out.area)
+                            : mean * (RealT(1) / RealT(children.size()));
+  out.radius = 0;
+  for (const auto &child : children) {
+    for (int i = 0; i < 9; ++i)
+      out.quadrupole[i] += child.quadrupole[i];
+    add_outer_product(out.quadrupole, child.dipole, child.center - out.center);
+    out.radius = std::max(out.radius,
+                          (child.center - out.center).length() + child.radius);
+  }
+  return out;
+}
+
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto compute_winding_moments(const tf::tree<Index, RealT, 3> &tree,
+                             const Range0 &triangles, const Range1 &points,
+                             tf::buffer<winding_moments<RealT>> &moments,
+                             Index id) -> void {
+  const auto &node = tree.nodes()[id];
+  const auto &data = node.get_data();
+  if (node.is_leaf()) {
+    moments[id] = leaf_winding_moments<RealT>(
+        tf::make_range(tree.ids().begin() + data[0], data[1]), triangles,
+        points);
+    return;
+  }
+  auto children = [&](Index begin, Index end) {
+    for (auto child = begin; child < end; ++child)
+      compute_winding_moments(tree, triangles, points, moments, child);
+  };
+  // children of large subtrees are computed in parallel
+  if (subtree_size(tree.nodes(), id) > 2048)
+    tbb::parallel_for(tbb::blocked_range<Index>(data[0], data[0] + data[1], 1),
+                      [&](const tbb::blocked_range<Index> &range) {
+                        children(range.begin(), range.end());
+                      });
+  else
+    children(data[0], data[0] + data[1]);
+  moments[id] = inner_winding_moments<RealT>(
+      tf::make_range(moments.begin() + data[0], data[1]));
+}
+
+// The solid angle of a triangle seen from the origin, over 4π (Van
+// Oosterom and Strackee).
+template <typename RealT>
+auto triangle_winding_number(const tf::vector<RealT, 3> &a,
+                             const tf::vector<RealT, 3> &b,
+                             const tf::vector<RealT, 3> &c) -> RealT {
+  auto la = a.length(), lb = b.length(), lc = c.length();
+  auto numerator = tf::dot(a, winding_cross(b, c));
+  auto denominator = la * lb * lc + tf::dot(a, b) * lc + tf::dot(a, c) * lb +
+                     tf::dot(b, c) * la;
+  return std::atan2(numerator, denominator) * RealT(1 / (2 * M_PI));
+}
+
+// The far-field approximation of the winding number of a node, with
+// r = center - query: the dipole term A · r / (4π|r|^3), and the quadrupole
+// term (tr(C) / |r|^3 - 3 rᵀ C r / |r|^5) / (4π).
+template <typename RealT>
+auto far_field_winding_number(const winding_moments<RealT> &moments,
+                              const tf::vector<RealT, 3> &r, RealT r2)
+    -> RealT {
+  auto inv_r = 1 / std::sqrt(r2);
+  auto inv_r3 = inv_r * inv_r * inv_r;
+  auto inv_r5 = inv_r3 * inv_r * inv_r;
+  const auto &c = moments.quadrupole;
+  RealT rcr = 0;
+  for (int i = 0; i < 3; ++i)
+    rcr += r[i] * (c[3 * i] * r[0] + c[3 * i + 1] * r[1] + c[3 * i + 2] * r[2]);
+  RealT trace = c[0] + c[4] + c[8];
+  return (tf::dot(moments.dipole, r) * inv_r3 + trace * inv_r3 -
+          3 * rcr * inv_r5) *
+         RealT(1 / (4 * M_PI));
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Far-field expansions for fast winding number queries on a
+/// triangle tree.
+///
+/// After the tree is built over the triangles of a mesh, `build` computes
+/// per-node dipole and quadrupole expansions of the winding number in one
+/// parallel bottom-up pass. Queries with @ref tf::winding_number and
+/// @ref tf::winding_numbers then use the expansion of any node that is far
+/// enough from the query point, and exact per-triangle solid angles only
+/// near it (Barill et al., "Fast Winding Numbers for Soups and Clouds").
+///
+/// The winding number is 1 inside a closed, outward-oriented mesh and 0
+/// outside. For open meshes and triangle soups it degrades gracefully, so
+/// thresholding at 0.5 classifies points robustly.
+///
+/// The object stores a pointer to the tree, which must outlive it. The
+/// expansions must be rebuilt when the tree or the points change.
+///
+/// @tparam Index The type used for primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+template <typename Index, typename RealT> class fast_winding_number {
+public:
+  /// @brief Compute the expansions for a tree built over `triangles`.
+  ///
+  /// @param tree The spatial tree built over `triangles`.
+  /// @param triangles A range of triangles, each a range of three point
+  /// indices.
+  /// @param points The points indexed by the triangles.
+  template <typename Range0, typename Range1>
+  auto build(const tf::tree<Index, RealT, 3> &tree, const Range0 &triangles,
+             const Range1 &points) -> void {
+    _tree = &tree;
+    _moments.allocate(tree.nodes().size());
+    if (tree.nodes().size())
+      implementation::compute_winding_moments(tree, triangles, points,
+                                              _moments, Index(0));
+  }
+
+  /// @brief The tree the expansions were built for.
+  auto tree() const -> const tf::tree<Index, RealT, 3> & { return *_tree; }
+
+  /// @brief The expansions, one per node of the tree.
+  auto moments() const
+      -> const tf::buffer<implementation::winding_moments<RealT>> & {
+    return _moments;
+  }
+
+private:
+  const tf::tree<Index, RealT, 3> *_tree = nullptr;
+  tf::buffer<implementation::winding_moments<RealT>> _moments;
+};
+
+/// @brief Evaluate the winding number of a mesh at a point.
+///
+/// Nodes whose bounding sphere, scaled by `accuracy`, does not contain the
+/// query are evaluated from their expansions. Leaves near the query are
+/// evaluated exactly, from the solid angles of their triangles.
+///
+/// @param winding The expansions, built over the tree of `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param query The query point.
+/// @param accuracy The ratio of the distance to a node and its radius above
+/// which the expansion is used. Larger values are more accurate and slower.
+///
+/// @return The winding number at `query`.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Point>
+auto winding_number(const tf::fast_winding_number<Index, RealT> &winding,
+                    const Range0 &triangles, const Range1 &points,
+                    const Point &query, RealT accuracy = 2) -> RealT {
+  const auto &nodes = winding.tree().nodes();
+  const auto &ids = winding.tree().ids();
+  const auto &moments = winding.moments();
+  if (!nodes.size())
+    return 0;
+  auto q = implementation::to_winding_point<RealT>(query);
+  auto accuracy2 = accuracy * accuracy;
+  RealT out = 0;
+  tf::small_buffer<Index, 64> stack;
+  stack.push_back(0);
+  while (stack.size()) {
+    auto id = stack.back();
+    stack.pop_back();
+    const auto &m = moments[id];
+    auto r = m.center - q;
+    auto r2 = r.length2();
+    if (r2 > accuracy2 * m.radius * m.radius) {
+      out += implementation::far_field_winding_number(m, r, r2);
+      continue;
+    }
+    const auto &node = nodes[id];
+    const auto &data = node.get_data();
+    if (node.is_leaf()) {
+      for (auto i = data[0]; i < data[0] + data[1]; ++i) {
+        const auto &t = triangles[ids[i]];
+        out += implementation::triangle_winding_number(
+            implementation::to_winding_point<RealT>(points[t[0]]) - q,
+            implementation::to_winding_point<RealT>(points[t[1]]) - q,
+            implementation::to_winding_point<RealT>(points[t[2]]) - q);
+      }
+    } else {
+      for (auto child = data[0]; child < data[0] + data[1]; ++child)
+        stack.push_back(child);
+    }
+  }
+  return out;
+}
+
+/// @brief Evaluate the winding number of a mesh at many points, in
+/// parallel.
+///
+/// See @ref tf::winding_number.
+///
+/// @param winding The expansions, built over the tree of `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param queries A range of query points.
+/// @param accuracy The ratio of the distance to a node and its radius above
+/// which the expansion is used. Larger values are more accurate and slower.
+///
+/// @return tf::buffer<RealT> with the winding number at each query.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2>
+auto winding_numbers(const tf::fast_winding_number<Index, RealT> &winding,
+                     const Range0 &triangles, const Range1 &points,
+                     const Range2 &queries, RealT accuracy = 2)
+    -> tf::buffer<RealT> {
+  tf::buffer<RealT> out;
+  out.allocate(queries.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, queries.size(), 64),
+                    [&](const tbb::blocked_range<std::size_t> &range) {
+                      for (auto i = range.begin(); i < range.end(); ++i)
+                        out[i] = tf::winding_number(winding, triangles, points,
+                                                    queries[i], accuracy);
+                    });
+  return out;
+}
+
+} // namespace tf
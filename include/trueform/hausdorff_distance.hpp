@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/tree_hausdorff.hpp"
+#include "./tree.hpp"
+#include "./tree_closest_point_pair.hpp"
+#include <utility>
+
+namespace tf {
+
+/// @brief Compute the directed Hausdorff distance from `tree0` to `tree1`.
+///
+/// Finds the primitive of `tree0` whose closest primitive in `tree1` is the
+/// farthest away, i.e. `max_i min_j closest_pts_f(i, j).metric`.
+///
+/// The search is a branch-and-bound over `tree0`. The largest distance found
+/// so far is a lower bound, shared by all threads. Primitives of `tree0` are
+/// visited in tree order. The search of each starts with the primitive of
+/// `tree1` closest to the previous one, and stops as soon as the primitive
+/// is closer than the lower bound. The maximal distance to that primitive of
+/// `tree1` bounds the distance of a whole node from above. Nodes whose upper
+/// bound does not exceed the lower bound are never refined, nor are their
+/// primitives evaluated. The top `paralelism_depth` levels of `tree0` are
+/// processed in parallel.
+///
+/// When the primitives of `tree0` are points, this is the exact Hausdorff
+/// distance. Otherwise the distance of a primitive is taken to be its
+/// minimal distance to `tree1`, as evaluated by `closest_pts_f`.
+///
+/// @param tree0 The tree whose primitives are measured.
+/// @param tree1 The tree that is measured against.
+/// @param closest_pts_f A function that evaluates the true distance between a pair of primitives.
+///                      Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param paralelism_depth The number of levels of `tree0` split into parallel tasks.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N> of the realizing pair. Its
+///         metric is the squared distance.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto directed_hausdorff_distance(const tf::tree<Index, RealT, N> &tree0,
+                                 const tf::tree<Index, RealT, N> &tree1,
+                                 const F &closest_pts_f,
+                                 int paralelism_depth = 6)
+    -> tf::tree_closest_point_pair<Index, RealT, N> {
+  return tf::implementation::tree_hausdorff(tree0, tree1, closest_pts_f,
+                                            paralelism_depth);
+}
+
+/// @brief Compute the symmetric Hausdorff distance between two trees.
+///
+/// The larger of the two directed Hausdorff distances, see
+/// @ref tf::directed_hausdorff_distance.
+///
+/// @param tree0 The first tree.
+/// @param tree1 The second tree.
+/// @param closest_pts_f A function that evaluates the true distance between a pair of primitives.
+///                      Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N> of the realizing pair,
+///         with `elements.first` referring to `tree0`. Its metric is the
+///         squared distance.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto hausdorff_distance(const tf::tree<Index, RealT, N> &tree0,
+                        const tf::tree<Index, RealT, N> &tree1,
+                        const F &closest_pts_f, int paralelism_depth = 6)
+    -> tf::tree_closest_point_pair<Index, RealT, N> {
+  auto forward = tf::implementation::tree_hausdorff(
+      tree0, tree1, closest_pts_f, paralelism_depth);
+  auto backward = tf::implementation::tree_hausdorff(
+      tree1, tree0,
+      [&closest_pts_f](Index id1, Index id0) {
+        auto c_points = closest_pts_f(id0, id1);
+        std::swap(c_points.first, c_points.second);
+        return c_points;
+      },
+      paralelism_depth);
+  if (!(forward.metric() < backward.metric()))
+    return forward;
+  std::swap(backward.elements.first, backward.elements.second);
+  std::swap(backward.points.first, backward.points.second);
+  return backward;
+}
+
+} // namespace tf
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+#include <atomic>
+
+namespace tf::implementation {
+
+// The number of primitives below a node. Primitives of a subtree are
+// contiguous in ids, so the count follows from the leftmost and the
+// rightmost leaf.
+template <typename Range> auto subtree_size(const Range &nodes, int id) -> int {
+  auto first = id;
+  while (!nodes[first].is_leaf())
+    first = nodes[first].get_data()[0];
+  auto last = id;
+  while (!nodes[last].is_leaf()) {
+    const auto &data = nodes[last].get_data();
+    last = data[0] + data[1] - 1;
+  }
+  const auto &first_data = nodes[first].get_data();
+  const auto &last_data = nodes[last].get_data();
+  return int(last_data[0] + last_data[1] - first_data[0]);
+}
+
+// Spawns work into a single task group shared by a whole traversal.
+//
+// Work is spawned only while fewer tasks wait in the queue than there are
+// threads to take them, and only when it is large enough to pay for a
+// task. Otherwise it runs inline. A thread that runs out of work steals a
+// queued task, and the thread that owns the remaining subtrees refills the
+// queue as it descends, so large subtrees are handed over where the work
+// actually is, instead of at a fixed depth.
+class adaptive_split {
+public:
+  // A `max_queued` of 0 runs everything inline.
+  explicit adaptive_split(int max_queued) : _max_queued{max_queued} {}
+
+  static auto make(int paralelism_depth) -> adaptive_split {
+    return adaptive_split{
+        paralelism_depth > 0 ? 2 * tbb::this_task_arena::max_concurrency()
+                             : 0};
+  }
+
+  // `work` estimates the number of primitives handled by `f`. It is only
+  // evaluated when a task could be spawned.
+  template <typename F, typename F1>
+  auto run(const F &f, const F1 &work) -> void {
+    if (_queued.load(std::memory_order_relaxed) < _max_queued &&
+        work() >= grain) {
+      _queued.fetch_add(1, std::memory_order_relaxed);
+      _tg.run([this, f] {
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        f();
+      });
+    } else
+      f();
+  }
+
+  auto wait() -> void { _tg.wait(); }
+
+private:
+  static constexpr int grain = 64;
+  tbb::task_group _tg;
+  std::atomic<int> _queued{0};
+  int _max_queued;
+};
+
+} // namespace tf::implementation
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../approximation.hpp"
+#include <cstddef>
+
+namespace tf::implementation {
+
+// Shrinks the pruning bound of the wrapped result by (1+ε)^2. Once the
+// evaluation cap is reached, metric() turns negative, pruning all nodes.
+template <typename Result, typename RealT> class approximate_result {
+public:
+  approximate_result(Result &result,
+                     const tf::approximation<RealT> &approximation)
+      : result{result},
+        shrink{RealT(1) /
+               ((1 + approximation.epsilon) * (1 + approximation.epsilon))},
+        evaluations_left{approximation.max_evaluations} {}
+
+  auto metric() -> RealT {
+    if (!evaluations_left)
+      return -1;
+    return result.metric() * shrink;
+  }
+
+  template <typename Element, typename Point>
+  auto update(const Element &element, const Point &point) -> void {
+    if (evaluations_left)
+      --evaluations_left;
+    result.update(element, point);
+  }
+
+  Result &result;
+
+private:
+  RealT shrink;
+  std::size_t evaluations_left;
+};
+
+} // namespace tf::implementation
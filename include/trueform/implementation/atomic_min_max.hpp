@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include <atomic>
+
+namespace tf::implementation {
+
+template <typename RealT>
+auto atomic_min(std::atomic<RealT> &value, RealT candidate) -> void {
+  auto current = value.load(std::memory_order_relaxed);
+  while (candidate < current &&
+         !value.compare_exchange_weak(current, candidate,
+                                      std::memory_order_relaxed))
+    ;
+}
+
+template <typename RealT>
+auto atomic_max(std::atomic<RealT> &value, RealT candidate) -> void {
+  auto current = value.load(std::memory_order_relaxed);
+  while (current < candidate &&
+         !value.compare_exchange_weak(current, candidate,
+                                      std::memory_order_relaxed))
+    ;
+}
+
+} // namespace tf::implementation
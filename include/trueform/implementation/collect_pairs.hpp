@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../buffer.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace tf::implementation {
+
+// Runs `search_f(locals)`, where each thread pushes values into its own
+// buffer `locals.local()`. The buffers are concatenated in parallel at the
+// end.
+template <typename T, typename F>
+auto collect_local_values(const F &search_f) -> tf::buffer<T> {
+  using values_t = tf::buffer<T>;
+  tbb::enumerable_thread_specific<values_t> locals;
+  search_f(locals);
+  // values of a single thread need no concatenation
+  if (locals.size() == 1)
+    return std::move(*locals.begin());
+
+  std::vector<const values_t *> chunks;
+  std::vector<std::size_t> offsets{0};
+  for (const auto &local : locals) {
+    chunks.push_back(&local);
+    offsets.push_back(offsets.back() + local.size());
+  }
+  values_t out;
+  out.allocate(offsets.back());
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, chunks.size(), 1),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          const auto &chunk = *chunks[i];
+          tbb::parallel_for(
+              tbb::blocked_range<std::size_t>(0, chunk.size()),
+              [&](const tbb::blocked_range<std::size_t> &r) {
+                std::copy(chunk.begin() + r.begin(), chunk.begin() + r.end(),
+                          out.begin() + offsets[i] + r.begin());
+              });
+        }
+      });
+  return out;
+}
+
+// Runs `search_f(push)`, where `push(value)` may be called from any
+// thread. Values are pushed into thread-local buffers, which are
+// concatenated in parallel at the end.
+template <typename T, typename F>
+auto collect_values(const F &search_f) -> tf::buffer<T> {
+  return collect_local_values<T>([&search_f](auto &locals) {
+    search_f([&locals](const T &value) { locals.local().push_back(value); });
+  });
+}
+
+// Runs `search_f(apply)`, where `apply(id0, id1)` may be called from any
+// thread, and collects the pairs.
+template <typename Index, typename F>
+auto collect_pairs(const F &search_f, bool sorted)
+    -> tf::buffer<std::array<Index, 2>> {
+  auto out = collect_values<std::array<Index, 2>>([&search_f](
+                                                      const auto &push) {
+    search_f([&push](Index id0, Index id1) { push({id0, id1}); });
+  });
+  if (sorted)
+    tbb::parallel_sort(out.begin(), out.end());
+  return out;
+}
+} // namespace tf::implementation
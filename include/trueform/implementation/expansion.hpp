@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../small_buffer.hpp"
+#include <cmath>
+
+namespace tf::implementation {
+
+// Exact arithmetic on floating-point expansions (Shewchuk, "Adaptive
+// Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates"). An expansion is a sum of non-overlapping doubles, stored
+// in order of increasing magnitude, without zeros. Used by the exact
+// fallbacks of the orientation predicates.
+using expansion = tf::small_buffer<double, 16>;
+
+inline auto two_sum(double a, double b, double &x, double &y) -> void {
+  x = a + b;
+  double b_virtual = x - a;
+  double a_virtual = x - b_virtual;
+  y = (a - a_virtual) + (b - b_virtual);
+}
+
+inline auto two_product(double a, double b, double &x, double &y) -> void {
+  x = a * b;
+  y = std::fma(a, b, -x);
+}
+
+// The exact difference `a - b`, as an expansion of up to two terms.
+inline auto make_expansion_difference(double a, double b) -> expansion {
+  double x, y;
+  two_sum(a, -b, x, y);
+  expansion out;
+  if (y != 0)
+    out.push_back(y);
+  if (x != 0)
+    out.push_back(x);
+  return out;
+}
+
+// h = e + f
+inline auto expansion_sum(const expansion &e, const expansion &f)
+    -> expansion {
+  expansion h;
+  if (!e.size())
+    return f;
+  if (!f.size())
+    return e;
+  // merge by magnitude, then accumulate with two_sum
+  expansion merged;
+  merged.reserve(e.size() + f.size());
+  std::size_t i = 0, j = 0;
+  while (i < e.size() && j < f.size())
+    merged.push_back(std::abs(e[i]) < std::abs(f[j]) ? e[i++] : f[j++]);
+  while (i < e.size())
+    merged.push_back(e[i++]);
+  while (j < f.size())
+    merged.push_back(f[j++]);
+  double q = merged[0];
+  for (std::size_t k = 1; k < merged.size(); ++k) {
+    double sum, error;
+    two_sum(q, merged[k], sum, error);
+    if (error != 0)
+      h.push_back(error);
+    q = sum;
+  }
+  if (q != 0 || !h.size())
+    h.push_back(q);
+  return h;
+}
+
+// h = e * b
+inline auto scale_expansion(const expansion &e, double b) -> expansion {
+  expansion h;
+  if (!e.size() || b == 0)
+    return h;
+  double q, error;
+  two_product(e[0], b, q, error);
+  if (error != 0)
+    h.push_back(error);
+  for (std::size_t i = 1; i < e.size(); ++i) {
+    double product, product_error, sum;
+    two_product(e[i], b, product, product_error);
+    two_sum(q, product_error, sum, error);
+    if (error != 0)
+      h.push_back(error);
+    two_sum(product, sum, q, error);
+    if (error != 0)
+      h.push_back(error);
+  }
+  if (q != 0 || !h.size())
+    h.push_back(q);
+  return h;
+}
+
+// h = e * f
+inline auto expansion_product(const expansion &e, const expansion &f)
+    -> expansion {
+  expansion h;
+  for (auto term : f)
+    h = expansion_sum(h, scale_expansion(e, term));
+  return h;
+}
+
+inline auto negate_expansion(expansion e) -> expansion {
+  for (auto &term : e)
+    term = -term;
+  return e;
+}
+
+// The sign of an expansion is the sign of its largest term.
+inline auto expansion_sign(const expansion &e) -> int {
+  for (std::size_t i = e.size(); i-- > 0;)
+    if (e[i] != 0)
+      return e[i] > 0 ? 1 : -1;
+  return 0;
+}
+
+// The exact sign of `ax * by - ay * bx`, for expansions.
+inline auto exact_cross(const expansion &ax, const expansion &ay,
+                        const expansion &bx, const expansion &by)
+    -> expansion {
+  return expansion_sum(expansion_product(ax, by),
+                       negate_expansion(expansion_product(ay, bx)));
+}
+
+} // namespace tf::implementation
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../aabb.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace tf::implementation {
+
+// Spreads the lower 10 bits of `x` to every third bit.
+inline auto expand_morton_bits(std::uint32_t x) -> std::uint32_t {
+  x &= 0x3ff;
+  x = (x | (x << 16)) & 0x030000ff;
+  x = (x | (x << 8)) & 0x0300f00f;
+  x = (x | (x << 4)) & 0x030c30c3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+// The 30-bit Morton code of a point, quantized on a 1024³ grid over `aabb`.
+// Points outside of the box are clamped to it.
+template <typename RealT, typename Point>
+auto morton_code(const tf::aabb<RealT, 3> &aabb, const Point &point)
+    -> std::uint32_t {
+  std::uint32_t code = 0;
+  for (int d = 0; d < 3; ++d) {
+    auto extent = aabb.max[d] - aabb.min[d];
+    RealT t = extent > 0 ? (RealT(point[d]) - aabb.min[d]) / extent : RealT(0);
+    auto cell = std::uint32_t(std::clamp(t, RealT(0), RealT(1)) * RealT(1023));
+    code |= expand_morton_bits(cell) << (2 - d);
+  }
+  return code;
+}
+
+} // namespace tf::implementation
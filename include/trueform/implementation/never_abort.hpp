@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+
+namespace tf::implementation {
+// The default `abort` of traversals that may be interrupted
+struct never_abort {
+  constexpr auto operator()() const -> bool { return false; }
+};
+} // namespace tf::implementation
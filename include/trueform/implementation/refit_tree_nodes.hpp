@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../aabb_union.hpp"
+#include "tbb/task_group.h"
+
+namespace tf::implementation {
+// Recomputes the boxes of the subtree of `node_id` from the boxes of its
+// primitives, bottom up. The structure of the tree is kept. Leaves that
+// hold no primitives keep their box.
+template <typename Range0, typename Range1, typename Range2>
+auto refit_tree_nodes(Range0 &nodes, const Range1 &ids, const Range2 &aabbs,
+                      int node_id, int depth) -> void {
+  auto &node = nodes[node_id];
+  const auto &data = node.get_data();
+  if (node.is_leaf()) {
+    if (!data[1])
+      return;
+    node.aabb = aabbs[ids[data[0]]];
+    for (auto i = data[0] + 1; i < data[0] + data[1]; ++i)
+      aabb_union_inplace(node.aabb, aabbs[ids[i]]);
+    return;
+  }
+  if (depth > 0) {
+    tbb::task_group tg;
+    for (auto child = data[0]; child < data[0] + data[1]; ++child)
+      tg.run([&nodes, &ids, &aabbs, child, depth] {
+        refit_tree_nodes(nodes, ids, aabbs, child, depth - 1);
+      });
+    tg.wait();
+  } else
+    for (auto child = data[0]; child < data[0] + data[1]; ++child)
+      refit_tree_nodes(nodes, ids, aabbs, child, depth);
+  node.aabb = nodes[data[0]].aabb;
+  for (auto child = data[0] + 1; child < data[0] + data[1]; ++child)
+    aabb_union_inplace(node.aabb, nodes[child].aabb);
+}
+} // namespace tf::implementation
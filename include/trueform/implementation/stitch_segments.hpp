@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../buffer.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace tf::implementation {
+
+// A segment whose endpoints are identified by keys. Segments that share an
+// endpoint key are consecutive in a polyline.
+template <typename Index, typename Point> struct keyed_segment {
+  std::array<std::array<Index, 4>, 2> keys;
+  std::array<Point, 2> points;
+};
+
+template <typename Index>
+auto hash_segment_key(const std::array<Index, 4> &key) -> std::uint64_t {
+  std::uint64_t h = 0;
+  for (auto k : key) {
+    h ^= std::uint64_t(k) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdull;
+  }
+  return h ^ (h >> 33);
+}
+
+// Joins the endpoints of segments that share a key, in parallel, through a
+// lock-free open-addressing hash table. Returns, for each endpoint
+// `2 * segment + end`, the joined endpoint plus one, or zero. When more than
+// two endpoints share a key, only one pair of them is joined.
+template <typename Index, typename Point>
+auto join_segment_endpoints(const tf::buffer<keyed_segment<Index, Point>> &segments)
+    -> std::vector<std::atomic<Index>> {
+  std::size_t n_endpoints = 2 * segments.size();
+  std::size_t n_slots = 16;
+  while (n_slots < 2 * n_endpoints)
+    n_slots *= 2;
+  std::size_t mask = n_slots - 1;
+  // slots and partners hold endpoint ids plus one, zero is empty
+  std::vector<std::atomic<Index>> slots(n_slots);
+  std::vector<std::atomic<Index>> partners(n_endpoints);
+  auto key = [&segments](std::size_t endpoint) -> const auto & {
+    return segments[endpoint / 2].keys[endpoint % 2];
+  };
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, n_endpoints),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto endpoint = range.begin(); endpoint < range.end(); ++endpoint) {
+          const auto &endpoint_key = key(endpoint);
+          auto slot = hash_segment_key(endpoint_key) & mask;
+          while (true) {
+            Index current = 0;
+            if (slots[slot].compare_exchange_strong(current,
+                                                    Index(endpoint + 1)))
+              break;
+            if (key(current - 1) == endpoint_key) {
+              Index none = 0;
+              if (partners[current - 1].compare_exchange_strong(
+                      none, Index(endpoint + 1)))
+                partners[endpoint].store(current);
+              break;
+            }
+            slot = (slot + 1) & mask;
+          }
+        }
+      });
+  return partners;
+}
+
+// Walks the joined segments into polylines. Open polylines are walked from
+// their free ends, the remaining segments form closed polylines, whose last
+// point repeats the first one.
+template <typename Index, typename Point>
+auto stitch_segments(const tf::buffer<keyed_segment<Index, Point>> &segments,
+                     tf::buffer<Point> &points, tf::buffer<Index> &offsets)
+    -> void {
+  auto partners = join_segment_endpoints(segments);
+  std::vector<char> visited(segments.size(), 0);
+  points.clear();
+  offsets.clear();
+  points.reserve(segments.size() + segments.size() / 4);
+  offsets.push_back(0);
+  auto walk = [&](std::size_t entry) {
+    points.push_back(segments[entry / 2].points[entry % 2]);
+    while (!visited[entry / 2]) {
+      visited[entry / 2] = 1;
+      auto exit = entry ^ 1;
+      points.push_back(segments[exit / 2].points[exit % 2]);
+      auto next = partners[exit].load(std::memory_order_relaxed);
+      if (!next)
+        break;
+      entry = next - 1;
+    }
+    offsets.push_back(Index(points.size()));
+  };
+  for (std::size_t endpoint = 0; endpoint < partners.size(); ++endpoint)
+    if (!visited[endpoint / 2] &&
+        !partners[endpoint].load(std::memory_order_relaxed))
+      walk(endpoint);
+  for (std::size_t segment = 0; segment < segments.size(); ++segment)
+    if (!visited[segment])
+      walk(2 * segment);
+}
+} // namespace tf::implementation
@@ -8,32 +8,45 @@
 #include "../range.hpp"
 #include "../small_buffer.hpp"
 #include "../tree_node.hpp"
+#include "./never_abort.hpp"
 
 namespace tf::implementation {
+template <typename Index, typename RealT> struct tree_closest_point_holder {
+  RealT metric;
+  Index id;
+
+  tree_closest_point_holder(Index id, RealT metric)
+      : metric{metric}, id{id} {};
+};
+
+// The traversal stack of the sorted closest point search. Batched queries
+// pass one per task, so that a stack that outgrew its inline storage is
+// not reallocated for every query.
+template <typename Index, typename RealT>
+using tree_closest_point_stack =
+    tf::small_buffer<tree_closest_point_holder<Index, RealT>, 256>;
+
+// `leaf_f(ids, result)` updates the result with the primitives of a leaf.
 template <typename Index, typename RealT, std::size_t N, typename F0,
-          typename F1, typename Result>
-auto tree_closest_point_using_sort_by_level(
+          typename F1, typename Result, typename F2 = never_abort>
+auto tree_closest_point_leaves_using_stack(
     const buffer<tree_node<Index, RealT, N>> &nodes, const buffer<Index> &ids,
-    const F0 &aabb_metric_f, const F1 &closest_point_f, Result &result) {
+    const F0 &aabb_metric_f, const F1 &leaf_f, Result &result,
+    tree_closest_point_stack<Index, RealT> &stack, Index root = 0,
+    const F2 &abort = F2{}) {
   if (!nodes.size())
     return;
-  using real_type = RealT;
-  struct holder_t {
-    real_type metric;
-    Index id;
-
-    holder_t(Index id, real_type metric) : metric{metric}, id{id} {};
-  };
-
-  tf::small_buffer<holder_t, 256> stack;
+  stack.clear();
 
   auto compare = [](const auto &x, const auto &y) {
     return x.metric > y.metric;
   };
 
-  stack.emplace_back(0, aabb_metric_f(nodes.front().aabb));
+  stack.emplace_back(root, aabb_metric_f(nodes[root].aabb));
 
   while (stack.size()) {
+    if (abort())
+      return;
     auto current = stack.back();
     stack.pop_back();
     if (current.metric > result.metric()) {
@@ -57,20 +70,46 @@ auto tree_closest_point_using_sort_by_level(
       std::sort(stack.begin() +
                     std::max(Index(current_offset) - data[1], Index(0)),
                 stack.end(), compare);
-    } else {
-      for (const auto &id : tf::make_range(ids.begin() + data[0], data[1])) {
-        auto closest_pt = closest_point_f(id);
-        result.update(id, closest_pt);
-      }
-    }
+    } else
+      leaf_f(tf::make_range(ids.begin() + data[0], data[1]), result);
   }
 }
 
+// `leaf_f(ids, result)` updates the result with the primitives of a leaf.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Result, typename F2 = never_abort>
+auto tree_closest_point_leaves_using_sort_by_level(
+    const buffer<tree_node<Index, RealT, N>> &nodes, const buffer<Index> &ids,
+    const F0 &aabb_metric_f, const F1 &leaf_f, Result &result,
+    Index root = 0, const F2 &abort = F2{}) {
+  tree_closest_point_stack<Index, RealT> stack;
+  tree_closest_point_leaves_using_stack(nodes, ids, aabb_metric_f, leaf_f,
+                                        result, stack, root, abort);
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Result, typename F2 = never_abort>
+auto tree_closest_point_using_sort_by_level(
+    const buffer<tree_node<Index, RealT, N>> &nodes, const buffer<Index> &ids,
+    const F0 &aabb_metric_f, const F1 &closest_point_f, Result &result,
+    Index root = 0, const F2 &abort = F2{}) {
+  tree_closest_point_leaves_using_sort_by_level(
+      nodes, ids, aabb_metric_f,
+      [&closest_point_f](const auto &leaf_ids, Result &result) {
+        for (const auto &id : leaf_ids) {
+          auto closest_pt = closest_point_f(id);
+          result.update(id, closest_pt);
+        }
+      },
+      result, root, abort);
+}
+
 template <typename Index, typename RealT, std::size_t N, typename F0,
-          typename F1, typename Result>
+          typename F1, typename Result, typename F2 = never_abort>
 auto tree_closest_point_using_heap(
     const buffer<tree_node<Index, RealT, N>> &nodes, const buffer<Index> &ids,
-    const F0 &aabb_metric_f, const F1 &closest_point_f, Result &result) {
+    const F0 &aabb_metric_f, const F1 &closest_point_f, Result &result,
+    Index root = 0, const F2 &abort = F2{}) {
   if (!nodes.size())
     return;
   using real_type = RealT;
@@ -87,10 +126,12 @@ auto tree_closest_point_using_heap(
     return x.metric > y.metric;
   };
 
-  heap.emplace_back(0, aabb_metric_f(nodes.front().aabb));
+  heap.emplace_back(root, aabb_metric_f(nodes[root].aabb));
   std::push_heap(heap.begin(), heap.end(), compare);
 
   while (heap.size()) {
+    if (abort())
+      return;
     std::pop_heap(heap.begin(), heap.end(), compare);
     auto current = heap.back();
     heap.pop_back();
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./adaptive_split.hpp"
+#include "tbb/enumerable_thread_specific.h"
+#include <cstddef>
+
+namespace tf::implementation {
+// The number of live primitives below a node. The main tree of a
+// `tf::mod_tree` only shrinks the ranges of its leaves on update, so the
+// removed ids are still within the span of the subtree. Summing the leaves
+// skips them.
+template <typename Range>
+auto live_subtree_size(const Range &nodes, int id) -> std::size_t {
+  const auto &data = nodes[id].get_data();
+  if (nodes[id].is_leaf())
+    return std::size_t(data[1]);
+  std::size_t size = 0;
+  for (auto child = data[0]; child < data[0] + data[1]; ++child)
+    size += live_subtree_size(nodes, child);
+  return size;
+}
+
+// The number of primitives below a node, for bulk counts. Only trees that
+// may hold removed ids (`has_removed`) walk their leaves, others take the
+// O(depth) span of the subtree.
+template <typename Range>
+auto bulk_subtree_size(const Range &nodes, int id, bool has_removed)
+    -> std::size_t {
+  return has_removed ? live_subtree_size(nodes, id)
+                     : std::size_t(subtree_size(nodes, id));
+}
+
+template <typename Range0, typename Range1, typename Range2, typename Range3,
+          typename F, typename F1, typename F2>
+struct tree_count_search_params {
+  const Range0 &nodes0;
+  const Range1 &ids0;
+  const Range2 &nodes1;
+  const Range3 &ids1;
+  const F &boxes_apply;
+  const F1 &boxes_contain;
+  const F2 &primitive_check;
+  bool is_self;
+  bool has_removed0;
+  bool has_removed1;
+  adaptive_split &split;
+  tbb::enumerable_thread_specific<std::size_t> &counts;
+};
+
+template <typename Params>
+auto tree_count_search(int id0, int id1, const Params &params) -> void {
+  const auto &node0 = params.nodes0[id0];
+  const auto &node1 = params.nodes1[id1];
+  auto is_self = params.is_self && id0 == id1;
+  // every pair of primitives below passes, count them in bulk
+  if (params.boxes_contain(node0.aabb, node1.aabb)) {
+    auto n0 = bulk_subtree_size(params.nodes0, id0, params.has_removed0);
+    auto n1 = is_self ? n0
+                      : bulk_subtree_size(params.nodes1, id1,
+                                          params.has_removed1);
+    params.counts.local() += is_self ? n0 * (n0 - 1) / 2 : n0 * n1;
+    return;
+  }
+  const auto &data0 = node0.get_data();
+  const auto &data1 = node1.get_data();
+  if (node0.is_leaf() && node1.is_leaf()) {
+    std::size_t count = 0;
+    for (std::size_t i0 = 0; i0 < std::size_t(data0[1]); ++i0) {
+      auto id = params.ids0[data0[0] + i0];
+      for (std::size_t i1 = is_self ? i0 + 1 : 0; i1 < std::size_t(data1[1]);
+           ++i1)
+        count += bool(params.primitive_check(id, params.ids1[data1[0] + i1]));
+    }
+    params.counts.local() += count;
+    return;
+  }
+  auto dispatch = [&params](int id0, int id1) {
+    params.split.run(
+        [&params, id0, id1] { tree_count_search(id0, id1, params); },
+        [&params, id0, id1] {
+          return subtree_size(params.nodes0, id0) +
+                 subtree_size(params.nodes1, id1);
+        });
+  };
+  if (node0.is_leaf()) {
+    for (auto n_id1 = data1[0]; n_id1 < data1[0] + data1[1]; ++n_id1)
+      if (params.boxes_apply(node0.aabb, params.nodes1[n_id1].aabb))
+        dispatch(id0, n_id1);
+  } else if (node1.is_leaf()) {
+    for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0)
+      if (params.boxes_apply(params.nodes0[n_id0].aabb, node1.aabb))
+        dispatch(n_id0, id1);
+  } else {
+    for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0)
+      for (auto n_id1 = is_self ? n_id0 : data1[0]; n_id1 < data1[0] + data1[1];
+           ++n_id1)
+        if ((is_self && n_id0 == n_id1) ||
+            params.boxes_apply(params.nodes0[n_id0].aabb,
+                               params.nodes1[n_id1].aabb))
+          dispatch(n_id0, n_id1);
+  }
+}
+
+// Counts the pairs of primitives that pass `primitive_check`, in pairs of
+// leaves that pass `boxes_apply`. Pairs of nodes that pass `boxes_contain`
+// are counted in bulk, as all pairs of primitives below them. For a self
+// search (`is_self`), each unordered pair of distinct primitives is counted
+// once. Trees whose leaves may hold removed ids, as the main tree of a
+// `tf::mod_tree`, are passed with `has_removed`, so that bulk counts include
+// only their live primitives.
+template <typename Range0, typename Range1, typename Range2, typename Range3,
+          typename F, typename F1, typename F2>
+auto tree_count_search(const Range0 &nodes0, const Range1 &ids0,
+                       const Range2 &nodes1, const Range3 &ids1, bool is_self,
+                       const F &boxes_apply, const F1 &boxes_contain,
+                       const F2 &primitive_check, int paralelism_depth = 6,
+                       bool has_removed0 = false, bool has_removed1 = false)
+    -> std::size_t {
+  if (!nodes0.size() || !nodes1.size())
+    return 0;
+  if (!is_self && !boxes_apply(nodes0[0].aabb, nodes1[0].aabb))
+    return 0;
+  tbb::enumerable_thread_specific<std::size_t> counts{std::size_t(0)};
+  auto split = adaptive_split::make(paralelism_depth);
+  tree_count_search_params<Range0, Range1, Range2, Range3, F, F1, F2> params{
+      nodes0,       ids0,          nodes1,          ids1,
+      boxes_apply,  boxes_contain, primitive_check, is_self,
+      has_removed0, has_removed1,  split,           counts};
+  tree_count_search(0, 0, params);
+  split.wait();
+  return counts.combine([](std::size_t a, std::size_t b) { return a + b; });
+}
+} // namespace tf::implementation
@@ -5,7 +5,8 @@
  */
 #pragma once
 #include "../range.hpp"
-#include "tbb/task_group.h"
+#include "./adaptive_split.hpp"
+#include <atomic>
 
 namespace tf::implementation {
 template <typename Range0, typename Range1, typename Range2, typename Range3,
@@ -18,13 +19,14 @@ struct tree_dual_search_params {
   const F &boxes_apply;
   const F1 &apply;
   const F2 &abort;
-  mutable bool found = false;
+  adaptive_split &split;
+  mutable std::atomic<bool> found{false};
 };
 
 template <typename Range0, typename Range1, typename Range2, typename Range3,
           typename F, typename F1, typename F2>
 auto tree_dual_search(
-    int id0, int id1, int depth,
+    int id0, int id1,
     const tree_dual_search_params<Range0, Range1, Range2, Range3, F, F1, F2>
         &params) {
   if (params.abort())
@@ -38,21 +40,20 @@ auto tree_dual_search(
     if (params.apply(
             tf::make_range(params.ids0.begin() + data0[0], data0[1]),
             tf::make_range(params.ids1.begin() + data1[0], data1[1]))) {
-      params.found = true;
+      params.found.store(true, std::memory_order_relaxed);
       return;
     }
 
   } else {
-    tbb::task_group tg;
     auto dispatch = [&](int id0, int id1) {
       if (params.abort())
         return false;
-      if (depth > 0)
-        tg.run([&params, id0, id1, depth] {
-          tree_dual_search(id0, id1, depth - 1, params);
-        });
-      else
-        tree_dual_search(id0, id1, depth, params);
+      params.split.run(
+          [&params, id0, id1] { tree_dual_search(id0, id1, params); },
+          [&params, id0, id1] {
+            return subtree_size(params.nodes0, id0) +
+                   subtree_size(params.nodes1, id1);
+          });
       return true;
     };
     if (node0.is_leaf()) {
@@ -72,10 +73,8 @@ auto tree_dual_search(
           if (params.boxes_apply(params.nodes0[n_id0].aabb,
                                  params.nodes1[n_id1].aabb))
             if (!dispatch(n_id0, n_id1))
-              goto wait_label;
+              return;
     }
-  wait_label:
-    tg.wait();
   }
 }
 
@@ -89,9 +88,13 @@ auto tree_dual_search(const Range0 &nodes0, const Range1 &ids0,
     return false;
   if (!boxes_apply(nodes0[0].aabb, nodes1[0].aabb))
     return false;
+  // a `paralelism_depth` of 0 runs the search serially,
+  // otherwise the work is split adaptively
+  auto split = adaptive_split::make(paralelism_depth);
   tree_dual_search_params<Range0, Range1, Range2, Range3, F, F1, F2> params{
-      nodes0, ids0, nodes1, ids1, boxes_apply, apply, abort};
-  tree_dual_search(0, 0, paralelism_depth, params);
-  return params.found;
+      nodes0, ids0, nodes1, ids1, boxes_apply, apply, abort, split};
+  tree_dual_search(0, 0, params);
+  split.wait();
+  return params.found.load();
 }
 } // namespace tf::implementation
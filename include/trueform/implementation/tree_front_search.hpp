@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../buffer.hpp"
+#include "../range.hpp"
+#include "../small_buffer.hpp"
+#include "../tree_node.hpp"
+#include "./collect_pairs.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_group.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace tf::implementation {
+
+// Parent and depth of every node, used to walk a node pair up the
+// traversal of a dual search.
+template <typename Index> struct tree_ancestry {
+  template <typename Range> auto build(const Range &nodes) -> void {
+    parents.allocate(nodes.size());
+    depths.allocate(nodes.size());
+    if (!nodes.size())
+      return;
+    parents[0] = Index(-1);
+    depths[0] = 0;
+    tf::small_buffer<Index, 64> stack;
+    stack.push_back(0);
+    while (stack.size()) {
+      auto id = stack.back();
+      stack.pop_back();
+      const auto &node = nodes[id];
+      if (node.is_leaf())
+        continue;
+      const auto &data = node.get_data();
+      for (auto child = data[0]; child < data[0] + data[1]; ++child) {
+        parents[child] = id;
+        depths[child] = depths[id] + 1;
+        stack.push_back(child);
+      }
+    }
+  }
+
+  auto clear() -> void {
+    parents.clear();
+    depths.clear();
+  }
+
+  tf::buffer<Index> parents;
+  tf::buffer<Index> depths;
+};
+
+// The nodes whose boxes changed since the last search, found by comparing
+// the nodes to a copy kept from then. A node is `changed` if its box or its
+// data differ. It is `changed_below` if it or any of its children changed.
+template <typename Index, typename RealT, std::size_t N>
+struct tree_changes {
+  template <typename Range> auto update(const Range &nodes) -> void {
+    auto n = nodes.size();
+    bool same_size = n == snapshot.size();
+    snapshot.allocate(n);
+    changed.allocate(n);
+    changed_below.allocate(n);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                        for (auto i = range.begin(); i < range.end(); ++i) {
+                          changed[i] = !same_size ||
+                                       differs(nodes[i], snapshot[i]);
+                          snapshot[i] = nodes[i];
+                        }
+                      });
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, n),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+          for (auto i = range.begin(); i < range.end(); ++i) {
+            bool below = changed[i];
+            const auto &node = nodes[i];
+            if (!node.is_leaf() && !node.is_empty()) {
+              const auto &data = node.get_data();
+              for (auto child = data[0]; child < data[0] + data[1]; ++child)
+                below = below || changed[child];
+            }
+            changed_below[i] = below;
+          }
+        });
+  }
+
+  auto clear() -> void {
+    snapshot.clear();
+    changed.clear();
+    changed_below.clear();
+  }
+
+  static auto differs(const tf::tree_node<Index, RealT, N> &a,
+                      const tf::tree_node<Index, RealT, N> &b) -> bool {
+    if (a.axis != b.axis || a.get_data() != b.get_data())
+      return true;
+    for (std::size_t i = 0; i < N; ++i)
+      if (a.aabb.min[i] != b.aabb.min[i] || a.aabb.max[i] != b.aabb.max[i])
+        return true;
+    return false;
+  }
+
+  tf::buffer<tf::tree_node<Index, RealT, N>> snapshot;
+  tf::buffer<char> changed;
+  tf::buffer<char> changed_below;
+};
+
+// What a pair of the front stands for. A bottom pair stands for all of its
+// child pairs, which were either separated or pairs of leaves. It is stored
+// instead of them, so that the front does not grow with the branching
+// factor, and `overlaps` marks its child pairs of overlapping leaves.
+enum class front_kind : std::uint8_t { untested, separated, leaves, bottom };
+
+template <typename Index> struct front_pair {
+  Index id0;
+  Index id1;
+  front_kind kind;
+  std::uint64_t overlaps;
+};
+
+template <typename Index, typename Range0, typename Range1, typename Range2,
+          typename Range3, typename F, typename F1, typename F2>
+struct tree_front_search_params {
+  const Range0 &nodes0;
+  const Range1 &ids0;
+  const Range2 &nodes1;
+  const Range3 &ids1;
+  const tree_ancestry<Index> &ancestry0;
+  const tree_ancestry<Index> &ancestry1;
+  const char *changed0;
+  const char *changed1;
+  const char *changed_below0;
+  const char *changed_below1;
+  const F &boxes_apply;
+  const F1 &apply;
+  const F2 &abort;
+  bool is_self;
+  mutable std::atomic<bool> found{false};
+  mutable std::atomic<bool> aborted{false};
+};
+
+// A pair of a dual search is spawned by the pair of parents while both nodes
+// are inner, and by (parent, leaf) once one side has reached a leaf.
+// Depths tell the two cases apart.
+template <typename Index, typename Params>
+auto tree_front_parent(Index id0, Index id1, const Params &params)
+    -> std::array<Index, 2> {
+  auto d0 = params.ancestry0.depths[id0];
+  auto d1 = params.ancestry1.depths[id1];
+  if (d0 == d1)
+    return {params.ancestry0.parents[id0], params.ancestry1.parents[id1]};
+  if (d0 > d1)
+    return {params.ancestry0.parents[id0], id1};
+  return {id0, params.ancestry1.parents[id1]};
+}
+
+template <typename Index, typename Params>
+auto tree_front_first_child(Index id0, Index id1, const Params &params)
+    -> std::array<Index, 2> {
+  const auto &node0 = params.nodes0[id0];
+  const auto &node1 = params.nodes1[id1];
+  return {node0.is_leaf() ? id0 : node0.get_data()[0],
+          node1.is_leaf() ? id1 : node1.get_data()[0]};
+}
+
+// Moves a separated pair up, for as long as the pair that spawned it is
+// separated as well. All pairs of the front below that pair arrive at it,
+// and only the one reached through first children pushes it.
+template <typename Index, typename Params, typename F>
+auto tree_front_pull_up(Index id0, Index id1, const Params &params,
+                        const F &push) -> void {
+  while (id0 != 0 || id1 != 0) {
+    auto parent = tree_front_parent(id0, id1, params);
+    // the pair of a node with itself is never separated
+    if (params.is_self && parent[0] == parent[1])
+      break;
+    if (params.boxes_apply(params.nodes0[parent[0]].aabb,
+                           params.nodes1[parent[1]].aabb))
+      break;
+    auto first = tree_front_first_child(parent[0], parent[1], params);
+    if (first[0] != id0 || first[1] != id1)
+      return;
+    id0 = parent[0];
+    id1 = parent[1];
+  }
+  push(front_pair<Index>{id0, id1, front_kind::separated, 0});
+}
+
+template <typename Index, typename Params>
+auto tree_front_apply(Index id0, Index id1, const Params &params) -> void {
+  const auto &data0 = params.nodes0[id0].get_data();
+  const auto &data1 = params.nodes1[id1].get_data();
+  if (params.apply(tf::make_range(params.ids0.begin() + data0[0], data0[1]),
+                   tf::make_range(params.ids1.begin() + data1[0], data1[1]),
+                   params.is_self && id0 == id1))
+    params.found.store(true, std::memory_order_relaxed);
+}
+
+// Calls `f(id0, id1)` for the child pairs of a pair, in the same order for
+// the descent and for the replay of a bottom pair.
+template <typename Index, typename Params, typename F>
+auto tree_front_children(Index id0, Index id1, const Params &params,
+                         const F &f) -> void {
+  const auto &node0 = params.nodes0[id0];
+  const auto &node1 = params.nodes1[id1];
+  const auto &data0 = node0.get_data();
+  const auto &data1 = node1.get_data();
+  if (node0.is_leaf()) {
+    for (auto n_id1 = data1[0]; n_id1 < data1[0] + data1[1]; ++n_id1)
+      f(id0, n_id1);
+  } else if (node1.is_leaf()) {
+    for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0)
+      f(n_id0, id1);
+  } else {
+    auto is_self = params.is_self && id0 == id1;
+    for (Index i0 = 0; i0 < data0[1]; ++i0)
+      for (Index i1 = is_self ? i0 : 0; i1 < data1[1]; ++i1)
+        f(data0[0] + i0, data1[0] + i1);
+  }
+}
+
+template <typename Params> auto tree_front_should_stop(const Params &params) {
+  if (params.found.load(std::memory_order_relaxed))
+    return true;
+  if (params.abort()) {
+    params.aborted.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+// Reapplies a pair of the front whose nodes did not change, without testing
+// any boxes.
+template <typename Index, typename Params, typename F>
+auto tree_front_replay(const front_pair<Index> &pair, const Params &params,
+                       const F &push) -> void {
+  push(pair);
+  if (pair.kind == front_kind::separated || tree_front_should_stop(params))
+    return;
+  if (pair.kind == front_kind::leaves) {
+    tree_front_apply(pair.id0, pair.id1, params);
+    return;
+  }
+  int k = 0;
+  tree_front_children(pair.id0, pair.id1, params,
+                      [&](Index n_id0, Index n_id1) {
+                        if (pair.overlaps >> k++ & 1)
+                          tree_front_apply(n_id0, n_id1, params);
+                      });
+}
+
+// Descends an overlapping pair. A pair whose child pairs are all separated
+// or pairs of leaves is pushed as a bottom pair.
+template <typename Index, typename Params, typename F>
+auto tree_front_descend(Index id0, Index id1, int depth, const Params &params,
+                        const F &push) -> void {
+  if (tree_front_should_stop(params))
+    return;
+  const auto &node0 = params.nodes0[id0];
+  const auto &node1 = params.nodes1[id1];
+  if (node0.is_leaf() && node1.is_leaf()) {
+    push(front_pair<Index>{id0, id1, front_kind::leaves, 0});
+    tree_front_apply(id0, id1, params);
+    return;
+  }
+  struct child_t {
+    Index id0;
+    Index id1;
+    bool overlaps;
+  };
+  tf::small_buffer<child_t, 64> children;
+  bool is_bottom = true;
+  std::uint64_t overlaps = 0;
+  tree_front_children(id0, id1, params, [&](Index n_id0, Index n_id1) {
+    bool child_overlaps = (params.is_self && n_id0 == n_id1) ||
+                          params.boxes_apply(params.nodes0[n_id0].aabb,
+                                             params.nodes1[n_id1].aabb);
+    if (child_overlaps) {
+      if (!(params.nodes0[n_id0].is_leaf() && params.nodes1[n_id1].is_leaf()))
+        is_bottom = false;
+      // the mask of a bottom pair holds at most 64 child pairs
+      else if (children.size() < 64)
+        overlaps |= std::uint64_t(1) << children.size();
+    }
+    children.push_back({n_id0, n_id1, child_overlaps});
+  });
+  if (is_bottom && children.size() <= 64) {
+    push(front_pair<Index>{id0, id1, front_kind::bottom, overlaps});
+    for (const auto &child : children)
+      if (child.overlaps)
+        tree_front_apply(child.id0, child.id1, params);
+    return;
+  }
+  if (depth > 0) {
+    tbb::task_group tg;
+    for (const auto &child : children) {
+      if (!child.overlaps)
+        push(
+            front_pair<Index>{child.id0, child.id1, front_kind::separated, 0});
+      else
+        tg.run([&params, &push, child, depth] {
+          tree_front_descend(child.id0, child.id1, depth - 1, params, push);
+        });
+    }
+    tg.wait();
+    return;
+  }
+  for (const auto &child : children) {
+    if (!child.overlaps)
+      push(front_pair<Index>{child.id0, child.id1, front_kind::separated, 0});
+    else
+      tree_front_descend(child.id0, child.id1, depth, params, push);
+  }
+}
+
+// Revalidates the front left by the previous search. Pairs whose nodes did
+// not change are kept and reapplied without testing their boxes. Other pairs
+// that overlap are descended. Separated pairs are kept, or pulled up when
+// `compact` is set. As pulling up relies on every separated pair below an
+// ancestor arriving at it, all separated pairs are tested when compacting.
+// The new front replaces the old one. If the search is aborted, the front is
+// incomplete and is cleared, so that the next search starts at the roots.
+template <typename Index, typename RealT, std::size_t N, typename Range0,
+          typename Range1, typename Range2, typename Range3, typename F,
+          typename F1, typename F2>
+auto tree_front_search(tf::buffer<front_pair<Index>> &front,
+                       const Range0 &nodes0, const Range1 &ids0,
+                       const tree_ancestry<Index> &ancestry0,
+                       const tree_changes<Index, RealT, N> &changes0,
+                       const Range2 &nodes1, const Range3 &ids1,
+                       const tree_ancestry<Index> &ancestry1,
+                       const tree_changes<Index, RealT, N> &changes1,
+                       bool is_self, const F &boxes_apply, const F1 &apply,
+                       const F2 &abort, bool compact,
+                       int paralelism_depth) -> bool {
+  if (!nodes0.size() || !nodes1.size()) {
+    front.clear();
+    return false;
+  }
+  if (!front.size())
+    front.push_back({Index(0), Index(0), front_kind::untested, 0});
+  tree_front_search_params<Index, Range0, Range1, Range2, Range3, F, F1, F2>
+      params{nodes0,
+             ids0,
+             nodes1,
+             ids1,
+             ancestry0,
+             ancestry1,
+             changes0.changed.begin(),
+             changes1.changed.begin(),
+             changes0.changed_below.begin(),
+             changes1.changed_below.begin(),
+             boxes_apply,
+             apply,
+             abort,
+             is_self};
+  auto is_unchanged = [&](const front_pair<Index> &pair) {
+    switch (pair.kind) {
+    case front_kind::separated:
+      return !compact && !params.changed0[pair.id0] &&
+             !params.changed1[pair.id1];
+    case front_kind::leaves:
+      return !params.changed0[pair.id0] && !params.changed1[pair.id1];
+    case front_kind::bottom:
+      return !params.changed_below0[pair.id0] &&
+             !params.changed_below1[pair.id1];
+    default:
+      return false;
+    }
+  };
+  auto process = [&](const front_pair<Index> &pair, int depth,
+                     const auto &push) {
+    auto id0 = pair.id0;
+    auto id1 = pair.id1;
+    if (is_unchanged(pair))
+      tree_front_replay(pair, params, push);
+    else if (!(is_self && id0 == id1) &&
+             !boxes_apply(nodes0[id0].aabb, nodes1[id1].aabb)) {
+      // testing the parent costs as much as the pair saves,
+      // so separated pairs are only pulled up when compacting
+      if (compact)
+        tree_front_pull_up(id0, id1, params, push);
+      else
+        push(front_pair<Index>{id0, id1, front_kind::separated, 0});
+    } else
+      tree_front_descend(id0, id1, depth, params, push);
+  };
+  auto next = collect_local_values<front_pair<Index>>([&](auto &locals) {
+    // a small front is near the roots, where the descent itself has to
+    // provide the parallelism, and its tasks push from other threads
+    if (front.size() < 64) {
+      auto push = [&locals](const front_pair<Index> &pair) {
+        locals.local().push_back(pair);
+      };
+      for (const auto &pair : front)
+        process(pair, paralelism_depth, push);
+      return;
+    }
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, front.size(), 64),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+          auto &local = locals.local();
+          auto push = [&local](const front_pair<Index> &pair) {
+            local.push_back(pair);
+          };
+          for (auto i = range.begin(); i < range.end(); ++i)
+            process(front[i], 0, push);
+        });
+  });
+  if (params.found.load() || params.aborted.load()) {
+    front.clear();
+    return params.found.load();
+  }
+  front = std::move(next);
+  return false;
+}
+} // namespace tf::implementation
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../buffer.hpp"
+#include "../range.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace tf::implementation {
+
+// A dual search that processes one level of node pairs at a time. The
+// frontier holds the overlapping pairs of a level as a flat array, split
+// into fixed blocks. Each block, in parallel:
+// - applies its pairs of leaves,
+// - expands its other pairs into child pairs and tests them with
+//   `boxes_apply`,
+// - writes the survivors into a buffer of its own.
+// The blocks are then compacted into the next frontier, at offsets given by
+// a prefix sum over their sizes. There is no recursion and no task per
+// pair. Memory grows with the widest level of overlapping pairs.
+template <typename Index, typename Range0, typename Range1, typename Range2,
+          typename Range3, typename F, typename F1, typename F2>
+auto tree_frontier_search(const Range0 &nodes0, const Range1 &ids0,
+                          const Range2 &nodes1, const Range3 &ids1,
+                          bool is_self, const F &boxes_apply, const F1 &apply,
+                          const F2 &abort) -> bool {
+  using pair_t = std::array<Index, 2>;
+  constexpr std::size_t block_size = 256;
+  if (!nodes0.size() || !nodes1.size())
+    return false;
+  if (!is_self && !boxes_apply(nodes0[0].aabb, nodes1[0].aabb))
+    return false;
+  tf::buffer<pair_t> frontier;
+  tf::buffer<pair_t> next;
+  // survivors of a block of the frontier
+  std::vector<tf::buffer<pair_t>> blocks;
+  std::vector<std::size_t> offsets;
+  frontier.push_back({Index(0), Index(0)});
+  std::atomic<bool> found{false};
+  std::atomic<bool> aborted{false};
+
+  auto expand = [&](const pair_t &pair, tf::buffer<pair_t> &out) {
+    auto [id0, id1] = pair;
+    const auto &node0 = nodes0[id0];
+    const auto &node1 = nodes1[id1];
+    const auto &data0 = node0.get_data();
+    const auto &data1 = node1.get_data();
+    if (node0.is_leaf() && node1.is_leaf()) {
+      if (apply(tf::make_range(ids0.begin() + data0[0], data0[1]),
+                tf::make_range(ids1.begin() + data1[0], data1[1]),
+                is_self && id0 == id1))
+        found.store(true, std::memory_order_relaxed);
+    } else if (node0.is_leaf()) {
+      for (auto c = data1[0]; c < data1[0] + data1[1]; ++c)
+        if (boxes_apply(node0.aabb, nodes1[c].aabb))
+          out.push_back({id0, Index(c)});
+    } else if (node1.is_leaf()) {
+      for (auto c = data0[0]; c < data0[0] + data0[1]; ++c)
+        if (boxes_apply(nodes0[c].aabb, node1.aabb))
+          out.push_back({Index(c), id1});
+    } else {
+      auto same = is_self && id0 == id1;
+      for (auto c0 = data0[0]; c0 < data0[0] + data0[1]; ++c0)
+        for (auto c1 = same ? c0 : data1[0]; c1 < data1[0] + data1[1]; ++c1)
+          if ((same && c0 == c1) ||
+              boxes_apply(nodes0[c0].aabb, nodes1[c1].aabb))
+            out.push_back({Index(c0), Index(c1)});
+    }
+  };
+
+  while (frontier.size()) {
+    auto n_blocks = (frontier.size() + block_size - 1) / block_size;
+    if (blocks.size() < n_blocks)
+      blocks.resize(n_blocks);
+    // expansion, box tests and leaf pairs, one block per task
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, n_blocks, 1),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+          for (auto b = range.begin(); b < range.end(); ++b) {
+            auto &out = blocks[b];
+            out.clear();
+            if (aborted.load(std::memory_order_relaxed))
+              continue;
+            if (abort()) {
+              aborted.store(true, std::memory_order_relaxed);
+              continue;
+            }
+            auto last = std::min(frontier.size(), (b + 1) * block_size);
+            for (auto i = b * block_size; i < last; ++i)
+              expand(frontier[i], out);
+          }
+        });
+    if (aborted.load())
+      break;
+    // compaction of the blocks into the next frontier
+    offsets.resize(n_blocks + 1);
+    offsets[0] = 0;
+    for (std::size_t b = 0; b < n_blocks; ++b)
+      offsets[b + 1] = offsets[b] + blocks[b].size();
+    next.allocate(offsets[n_blocks]);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n_blocks, 1),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                        for (auto b = range.begin(); b < range.end(); ++b)
+                          std::copy(blocks[b].begin(), blocks[b].end(),
+                                    next.begin() + offsets[b]);
+                      });
+    std::swap(frontier, next);
+  }
+  return found.load();
+}
+} // namespace tf::implementation
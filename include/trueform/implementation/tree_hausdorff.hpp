@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../distance.hpp"
+#include "../maximal_distance.hpp"
+#include "../tree.hpp"
+#include "../tree_closest_point_pair.hpp"
+#include "./atomic_min_max.hpp"
+#include "./tree_closest_point_using_sort_by_level.hpp"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_group.h"
+#include <atomic>
+#include <limits>
+
+namespace tf::implementation {
+
+// The distance from a single primitive of tree0 to tree1. Given a lower
+// bound, the search is abandoned (metric() turns negative, pruning all
+// nodes) as soon as the primitive is found to be closer than the current
+// Hausdorff lower bound, as it can no longer raise it.
+template <typename Index, typename RealT, std::size_t N>
+class hausdorff_primitive_result {
+public:
+  hausdorff_primitive_result(Index id0, const std::atomic<RealT> *lower_bound)
+      : id0{id0}, lower_bound{lower_bound} {
+    points.points.metric = std::numeric_limits<RealT>::max();
+  }
+
+  auto metric() const -> RealT {
+    if (lower_bound &&
+        points.points.metric <= lower_bound->load(std::memory_order_relaxed))
+      return -1;
+    return points.points.metric;
+  }
+
+  auto update(Index id1, const tf::closest_point_pair<RealT, N> &c_points)
+      -> void {
+    if (c_points.metric < points.points.metric) {
+      points.elements = {id0, id1};
+      points.points = c_points;
+    }
+  }
+
+  Index id0;
+  const std::atomic<RealT> *lower_bound;
+  tf::tree_closest_point_pair<Index, RealT, N> points;
+};
+
+// Thread-local state. The primitive of tree1 closest to the last evaluated
+// primitive of tree0 is close to the next one, as primitives are visited
+// in tree order.
+template <typename Index, typename RealT, std::size_t N>
+struct hausdorff_local {
+  tf::tree_closest_point_pair<Index, RealT, N> farthest;
+  Index last;
+  bool has_last = false;
+};
+
+template <typename Index, typename RealT, std::size_t N, typename F,
+          typename Locals>
+struct tree_hausdorff_params {
+  const tf::tree<Index, RealT, N> &tree0;
+  const tf::tree<Index, RealT, N> &tree1;
+  const F &closest_pts_f;
+  Locals &locals;
+  std::atomic<RealT> &lower_bound;
+};
+
+// Any primitive of tree1 is an upper bound on the distance of everything
+// within `aabb` to tree1. Returns whether the last closest primitive shows
+// that nothing within `aabb` can raise the lower bound.
+template <typename Index, typename RealT, std::size_t N, typename F,
+          typename Locals>
+auto tree_hausdorff_is_bounded(
+    const tf::aabb<RealT, N> &aabb,
+    const hausdorff_local<Index, RealT, N> &local,
+    const tree_hausdorff_params<Index, RealT, N, F, Locals> &params) -> bool {
+  return local.has_last &&
+         tf::maximal_distance2(aabb,
+                               params.tree1.primitive_aabbs()[local.last]) <=
+             params.lower_bound.load(std::memory_order_relaxed);
+}
+
+// Evaluates the primitives of a leaf of tree0. The search of each starts
+// with the last closest primitive, and is abandoned as soon as it is closer
+// than the lower bound.
+template <typename Index, typename RealT, std::size_t N, typename F,
+          typename Locals>
+auto tree_hausdorff_leaf(
+    Index id0, hausdorff_local<Index, RealT, N> &local,
+    const tree_hausdorff_params<Index, RealT, N, F, Locals> &params) -> void {
+  const auto &aabbs0 = params.tree0.primitive_aabbs();
+  const auto &data0 = params.tree0.nodes()[id0].get_data();
+  for (const auto &id :
+       tf::make_range(params.tree0.ids().begin() + data0[0], data0[1])) {
+    const auto &aabb0 = aabbs0[id];
+    if (tree_hausdorff_is_bounded(aabb0, local, params))
+      continue;
+    hausdorff_primitive_result<Index, RealT, N> result{id,
+                                                       &params.lower_bound};
+    auto closest_point_f = [&params, id](Index id1) {
+      return params.closest_pts_f(id, id1);
+    };
+    if (local.has_last)
+      result.update(local.last, closest_point_f(local.last));
+    if (result.metric() >= 0)
+      tree_closest_point_using_sort_by_level(
+          params.tree1.nodes(), params.tree1.ids(),
+          [&aabb0](const tf::aabb<RealT, N> &aabb) {
+            return tf::distance2(aabb0, aabb);
+          },
+          closest_point_f, result);
+    if (result.points.points.metric < std::numeric_limits<RealT>::max()) {
+      local.last = result.points.elements.second;
+      local.has_last = true;
+    }
+    if (result.metric() < 0)
+      continue;
+    atomic_max(params.lower_bound, result.points.metric());
+    if (local.farthest.metric() < result.points.metric())
+      local.farthest = result.points;
+  }
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F,
+          typename Locals>
+auto tree_hausdorff(
+    Index id0, int depth,
+    const tree_hausdorff_params<Index, RealT, N, F, Locals> &params) -> void {
+  const auto &node0 = params.tree0.nodes()[id0];
+  auto &local = params.locals.local();
+  // no primitive of this node can raise the lower bound
+  if (tree_hausdorff_is_bounded(node0.aabb, local, params))
+    return;
+  if (node0.is_leaf()) {
+    tree_hausdorff_leaf(id0, local, params);
+    return;
+  }
+  const auto &data0 = node0.get_data();
+  tbb::task_group tg;
+  for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0) {
+    if (depth > 0)
+      tg.run([&params, n_id0, depth] {
+        tree_hausdorff(n_id0, depth - 1, params);
+      });
+    else
+      tree_hausdorff(n_id0, depth, params);
+  }
+  tg.wait();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto tree_hausdorff(const tf::tree<Index, RealT, N> &tree0,
+                    const tf::tree<Index, RealT, N> &tree1,
+                    const F &closest_pts_f, int paralelism_depth)
+    -> tf::tree_closest_point_pair<Index, RealT, N> {
+  tf::tree_closest_point_pair<Index, RealT, N> out;
+  if (!tree0.nodes().size() || !tree1.nodes().size())
+    return out;
+  // below any distance, so that coinciding primitives are recorded
+  std::atomic<RealT> lower_bound{-1};
+  tbb::enumerable_thread_specific<hausdorff_local<Index, RealT, N>> locals(
+      [] {
+        hausdorff_local<Index, RealT, N> local;
+        local.farthest.points.metric = -1;
+        return local;
+      });
+  tree_hausdorff_params<Index, RealT, N, F, decltype(locals)> params{
+      tree0, tree1, closest_pts_f, locals, lower_bound};
+  tree_hausdorff(Index(0), paralelism_depth, params);
+  out.points.metric = -1;
+  for (const auto &local : locals)
+    if (out.metric() < local.farthest.metric())
+      out = local.farthest;
+  return out;
+}
+
+} // namespace tf::implementation
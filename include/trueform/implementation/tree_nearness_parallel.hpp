@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../small_buffer.hpp"
+#include "../tree.hpp"
+#include "../tree_knn.hpp"
+#include "./atomic_min_max.hpp"
+#include "./never_abort.hpp"
+#include "./tree_closest_point.hpp"
+#include "./tree_closest_point_pair.hpp"
+#include "./tree_closest_point_using_sort_by_level.hpp"
+#include "./tree_tree_proximity.hpp"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_group.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace tf::implementation {
+
+// Thread-local results. Each thread accumulates into its own
+// result, which are merged into the user result at the end.
+template <typename Result> class nearness_local;
+
+template <typename Index, typename RealT, std::size_t Dims>
+class nearness_local<tree_closest_point<Index, RealT, Dims>> {
+public:
+  nearness_local(const tree_closest_point<Index, RealT, Dims> &)
+      : result{std::numeric_limits<RealT>::max()} {}
+
+  auto merge_into(tree_closest_point<Index, RealT, Dims> &out) const -> void {
+    out.update(result.point.element, result.point.point);
+  }
+
+  tree_closest_point<Index, RealT, Dims> result;
+};
+
+template <typename Index, typename RealT, std::size_t Dims>
+class nearness_local<tree_closest_point_pair<Index, RealT, Dims>> {
+public:
+  nearness_local(const tree_closest_point_pair<Index, RealT, Dims> &)
+      : result{std::numeric_limits<RealT>::max()} {}
+
+  auto merge_into(tree_closest_point_pair<Index, RealT, Dims> &out) const
+      -> void {
+    out.update(result.points.elements, result.points.points);
+  }
+
+  tree_closest_point_pair<Index, RealT, Dims> result;
+};
+
+template <typename RandomIt> class nearness_local<tf::tree_knn<RandomIt>> {
+  using value_t = typename std::iterator_traits<RandomIt>::value_type;
+  using iterator_t = typename std::vector<value_t>::iterator;
+
+public:
+  nearness_local(const tf::tree_knn<RandomIt> &knn)
+      : buffer(knn.max_size()),
+        result{knn.is_heap() ? tf::make_tree_knn(strategy::knn_heap,
+                                                 buffer.begin(), buffer.size())
+                             : tf::make_tree_knn(strategy::knn_sorted,
+                                                 buffer.begin(),
+                                                 buffer.size())} {}
+
+  nearness_local(const nearness_local &) = delete;
+  auto operator=(const nearness_local &) -> nearness_local & = delete;
+
+  auto merge_into(tf::tree_knn<RandomIt> &out) -> void {
+    for (const auto &e : result)
+      update(out, e);
+  }
+
+  std::vector<value_t> buffer;
+  tf::tree_knn<iterator_t> result;
+
+private:
+  template <typename Index, typename RealT, std::size_t Dims>
+  static auto update(tf::tree_knn<RandomIt> &out,
+                     const tf::tree_closest_point<Index, RealT, Dims> &e)
+      -> void {
+    out.update(e.element, e.point);
+  }
+
+  template <typename Index, typename RealT, std::size_t Dims>
+  static auto update(tf::tree_knn<RandomIt> &out,
+                     const tf::tree_closest_point_pair<Index, RealT, Dims> &e)
+      -> void {
+    out.update(e.elements, e.points);
+  }
+};
+
+// Prunes by the tighter of the thread-local bound and the bound
+// shared by all threads. Updates tighten the shared bound.
+template <typename Result, typename RealT> class shared_bound_result {
+public:
+  shared_bound_result(Result &local, std::atomic<RealT> &bound)
+      : local{local}, bound{bound} {}
+
+  auto metric() -> RealT {
+    return std::min(RealT(local.metric()),
+                    bound.load(std::memory_order_relaxed));
+  }
+
+  template <typename Element, typename Point>
+  auto update(const Element &element, const Point &point) -> void {
+    if (!(point.metric < metric()))
+      return;
+    local.update(element, point);
+    atomic_min(bound, RealT(local.metric()));
+  }
+
+  Result &local;
+  std::atomic<RealT> &bound;
+};
+
+template <typename Result, typename RealT>
+auto use_min_max_bound(const shared_bound_result<Result, RealT> &result)
+    -> bool {
+  return use_min_max_bound(result.local);
+}
+
+template <typename Index, typename RealT> struct nearness_parallel_holder {
+  RealT metric;
+  Index id0;
+  Index id1;
+};
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Locals, typename F2>
+struct tree_closest_point_parallel_params {
+  const buffer<tree_node<Index, RealT, N>> &nodes;
+  const buffer<Index> &ids;
+  const F0 &aabb_metric_f;
+  const F1 &closest_point_f;
+  Locals &locals;
+  std::atomic<RealT> &bound;
+  const F2 &abort;
+};
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Locals, typename F2>
+auto tree_closest_point_parallel(
+    Index id, RealT metric, int depth,
+    const tree_closest_point_parallel_params<Index, RealT, N, F0, F1, Locals,
+                                             F2> &params) -> void {
+  if (metric > params.bound.load(std::memory_order_relaxed) || params.abort())
+    return;
+  const auto &node = params.nodes[id];
+  if (node.is_leaf() || depth <= 0) {
+    auto &local = params.locals.local();
+    shared_bound_result<decltype(local.result), RealT> result{local.result,
+                                                              params.bound};
+    tree_closest_point_using_sort_by_level(
+        params.nodes, params.ids, params.aabb_metric_f, params.closest_point_f,
+        result, id, params.abort);
+    return;
+  }
+  const auto &data = node.get_data();
+  tf::small_buffer<nearness_parallel_holder<Index, RealT>, 16> children;
+  for (auto next_id = data[0]; next_id < data[0] + data[1]; ++next_id)
+    children.push_back(
+        {params.aabb_metric_f(params.nodes[next_id].aabb), next_id, next_id});
+  std::sort(children.begin(), children.end(),
+            [](const auto &x, const auto &y) { return x.metric < y.metric; });
+  // the closest child is processed by this thread, to
+  // tighten the shared bound as early as possible
+  tbb::task_group tg;
+  for (std::size_t i = 1; i < children.size(); ++i)
+    tg.run([&params, child = children[i], depth] {
+      tree_closest_point_parallel(child.id0, child.metric, depth - 1, params);
+    });
+  tree_closest_point_parallel(children[0].id0, children[0].metric, depth - 1,
+                              params);
+  tg.wait();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Result, typename F2 = never_abort>
+auto tree_closest_point_parallel(
+    const buffer<tree_node<Index, RealT, N>> &nodes, const buffer<Index> &ids,
+    const F0 &aabb_metric_f, const F1 &closest_point_f, Result &result,
+    int paralelism_depth = 4, const F2 &abort = F2{}) -> void {
+  if (!nodes.size())
+    return;
+  std::atomic<RealT> bound{result.metric()};
+  using locals_t = tbb::enumerable_thread_specific<nearness_local<Result>>;
+  locals_t locals(result);
+  tree_closest_point_parallel_params<Index, RealT, N, F0, F1, locals_t, F2>
+      params{nodes, ids, aabb_metric_f, closest_point_f, locals, bound, abort};
+  tree_closest_point_parallel(Index(0), aabb_metric_f(nodes[0].aabb),
+                              paralelism_depth, params);
+  for (auto &local : locals)
+    local.merge_into(result);
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Locals, typename F2>
+struct tree_tree_proximity_parallel_params {
+  const tf::tree<Index, RealT, N> &tree0;
+  const tf::tree<Index, RealT, N> &tree1;
+  const F0 &aabb_dists_f;
+  const F1 &closest_pts;
+  Locals &locals;
+  std::atomic<RealT> &bound;
+  const F2 &abort;
+};
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Locals, typename F2>
+auto tree_tree_proximity_parallel(
+    Index id0, Index id1, RealT metric, int depth,
+    const tree_tree_proximity_parallel_params<Index, RealT, N, F0, F1, Locals,
+                                              F2> &params) -> void {
+  if (metric > params.bound.load(std::memory_order_relaxed) || params.abort())
+    return;
+  const auto &nodes0 = params.tree0.nodes();
+  const auto &nodes1 = params.tree1.nodes();
+  const auto &node0 = nodes0[id0];
+  const auto &node1 = nodes1[id1];
+  if ((node0.is_leaf() && node1.is_leaf()) || depth <= 0) {
+    auto &local = params.locals.local();
+    shared_bound_result<decltype(local.result), RealT> result{local.result,
+                                                              params.bound};
+    tree_tree_proximity_sort(params.tree0, params.tree1, params.aabb_dists_f,
+                             params.closest_pts, result, id0, id1,
+                             params.abort);
+    return;
+  }
+  const auto &data0 = node0.get_data();
+  const auto &data1 = node1.get_data();
+  tf::small_buffer<nearness_parallel_holder<Index, RealT>, 64> children;
+  auto push_f = [&](Index n_id0, Index n_id1) {
+    auto ds2 = params.aabb_dists_f(nodes0[n_id0].aabb, nodes1[n_id1].aabb);
+    if (ds2.min_d2 <= params.bound.load(std::memory_order_relaxed))
+      children.push_back({ds2.min_d2, n_id0, n_id1});
+  };
+  if (!node0.is_leaf() && !node1.is_leaf()) {
+    for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0)
+      for (auto n_id1 = data1[0]; n_id1 < data1[0] + data1[1]; ++n_id1)
+        push_f(n_id0, n_id1);
+  } else if (!node0.is_leaf()) {
+    for (auto n_id0 = data0[0]; n_id0 < data0[0] + data0[1]; ++n_id0)
+      push_f(n_id0, id1);
+  } else {
+    for (auto n_id1 = data1[0]; n_id1 < data1[0] + data1[1]; ++n_id1)
+      push_f(id0, n_id1);
+  }
+  if (!children.size())
+    return;
+  std::sort(children.begin(), children.end(),
+            [](const auto &x, const auto &y) { return x.metric < y.metric; });
+  // the closest pair is processed by this thread, to
+  // tighten the shared bound as early as possible
+  tbb::task_group tg;
+  for (std::size_t i = 1; i < children.size(); ++i)
+    tg.run([&params, child = children[i], depth] {
+      tree_tree_proximity_parallel(child.id0, child.id1, child.metric,
+                                   depth - 1, params);
+    });
+  tree_tree_proximity_parallel(children[0].id0, children[0].id1,
+                               children[0].metric, depth - 1, params);
+  tg.wait();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename Result, typename F2 = never_abort>
+auto tree_tree_proximity_parallel(const tf::tree<Index, RealT, N> &tree0,
+                                  const tf::tree<Index, RealT, N> &tree1,
+                                  const F0 &aabb_dists_f,
+                                  const F1 &closest_pts, Result &result,
+                                  int paralelism_depth = 3,
+                                  const F2 &abort = F2{}) -> void {
+  if (!tree0.nodes().size() || !tree1.nodes().size())
+    return;
+  std::atomic<RealT> bound{result.metric()};
+  using locals_t = tbb::enumerable_thread_specific<nearness_local<Result>>;
+  locals_t locals(result);
+  tree_tree_proximity_parallel_params<Index, RealT, N, F0, F1, locals_t, F2>
+      params{tree0, tree1, aabb_dists_f, closest_pts, locals, bound, abort};
+  auto ds2 = aabb_dists_f(tree0.nodes()[0].aabb, tree1.nodes()[0].aabb);
+  tree_tree_proximity_parallel(Index(0), Index(0), RealT(ds2.min_d2),
+                               paralelism_depth, params);
+  for (auto &local : locals)
+    local.merge_into(result);
+}
+
+} // namespace tf::implementation
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "../buffer.hpp"
+#include "../range.hpp"
+#include "../small_buffer.hpp"
+#include "../tree_node.hpp"
+#include "./never_abort.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include <algorithm>
+#include <vector>
+
+namespace tf::implementation {
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2, typename F3 = never_abort>
+auto tree_radius_search(const buffer<tree_node<Index, RealT, N>> &nodes,
+                        const buffer<Index> &ids, const F0 &aabb_metric_f,
+                        const F1 &closest_point_f, RealT metric_bound,
+                        const F2 &apply, const F3 &abort = F3{}) -> void {
+  if (!nodes.size())
+    return;
+  tf::small_buffer<Index, 512> stack;
+  stack.push_back(0);
+  while (stack.size()) {
+    if (abort())
+      return;
+    auto current_i = stack.back();
+    stack.pop_back();
+    const auto &node = nodes[current_i];
+    if (aabb_metric_f(node.aabb) > metric_bound)
+      continue;
+    const auto &data = node.get_data();
+    if (node.is_leaf()) {
+      for (const auto &id : tf::make_range(ids.begin() + data[0], data[1])) {
+        auto metric = closest_point_f(id).metric;
+        if (metric <= metric_bound)
+          apply(id, metric);
+      }
+      continue;
+    }
+    for (auto next_id = data[0]; next_id < data[0] + data[1]; ++next_id)
+      stack.push_back(next_id);
+  }
+}
+
+// Results of a contiguous block of queries, stored in
+// the buffers of the thread that processed it.
+struct radius_search_chunk {
+  std::size_t query_begin;
+  std::size_t query_end;
+  std::size_t result_begin;
+};
+
+template <typename Index, typename RealT> struct radius_search_local {
+  tf::buffer<Index> ids;
+  tf::buffer<RealT> metrics;
+  std::vector<radius_search_chunk> chunks;
+};
+
+// Runs `search_f(query_id, apply)` for all queries in parallel. Each thread
+// appends into its own buffers. The per-query counts are prefix-summed
+// into `offsets` and the thread-local chunks concatenated at the end,
+// without locks or atomics.
+template <typename Index, typename RealT, typename F>
+auto batched_radius_search(std::size_t n_queries, const F &search_f,
+                           tf::buffer<Index> &offsets, tf::buffer<Index> &ids,
+                           tf::buffer<RealT> &metrics) -> void {
+  offsets.allocate(n_queries + 1);
+  offsets[0] = 0;
+  tbb::enumerable_thread_specific<radius_search_local<Index, RealT>> locals;
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, n_queries),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        auto &local = locals.local();
+        local.chunks.push_back(
+            {range.begin(), range.end(), local.ids.size()});
+        for (auto q = range.begin(); q < range.end(); ++q) {
+          auto size = local.ids.size();
+          search_f(q, [&local](Index id, RealT metric) {
+            local.ids.push_back(id);
+            local.metrics.push_back(metric);
+          });
+          offsets[q + 1] = local.ids.size() - size;
+        }
+      });
+  for (std::size_t q = 0; q < n_queries; ++q)
+    offsets[q + 1] += offsets[q];
+  ids.allocate(offsets[n_queries]);
+  metrics.allocate(offsets[n_queries]);
+
+  std::vector<std::pair<const radius_search_local<Index, RealT> *,
+                        radius_search_chunk>>
+      chunks;
+  for (const auto &local : locals)
+    for (const auto &chunk : local.chunks)
+      chunks.emplace_back(&local, chunk);
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, chunks.size()),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          const auto &[local, chunk] = chunks[i];
+          auto write_to = offsets[chunk.query_begin];
+          auto size = offsets[chunk.query_end] - write_to;
+          std::copy(local->ids.begin() + chunk.result_begin,
+                    local->ids.begin() + chunk.result_begin + size,
+                    ids.begin() + write_to);
+          std::copy(local->metrics.begin() + chunk.result_begin,
+                    local->metrics.begin() + chunk.result_begin + size,
+                    metrics.begin() + write_to);
+        }
+      });
+}
+} // namespace tf::implementation
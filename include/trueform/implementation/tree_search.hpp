@@ -8,18 +8,21 @@
 #include "../range.hpp"
 #include "../small_buffer.hpp"
 #include "../tree_node.hpp"
+#include "./never_abort.hpp"
 
 namespace tf::implementation {
 template <typename Index, typename RealT, std::size_t N, typename F0,
-          typename F1>
+          typename F1, typename F2 = never_abort>
 auto tree_search(const buffer<tree_node<Index, RealT, N>> &nodes,
                  const buffer<Index> &ids, const F0 &aabb_check,
-                 const F1 &leaf_apply) {
+                 const F1 &leaf_apply, const F2 &abort = F2{}) {
   if (!nodes.size())
     return false;
   tf::small_buffer<Index, 512> stack;
   stack.push_back(0);
   while (stack.size()) {
+    if (abort())
+      return false;
     auto current_i = stack.back();
     stack.pop_back();
     const auto &node = nodes[current_i];
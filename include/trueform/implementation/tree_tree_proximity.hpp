@@ -7,13 +7,28 @@
 
 #include "../small_buffer.hpp"
 #include "../tree.hpp"
+#include "../tree_knn.hpp"
+#include "./never_abort.hpp"
 namespace tf::implementation {
+// The min-max distance of a node pair only bounds the distance
+// of a single primitive pair. It may prune the search only
+// when a single closest pair is being tracked.
+template <typename Result> auto use_min_max_bound(const Result &) -> bool {
+  return true;
+}
+
+template <typename RandomIt>
+auto use_min_max_bound(const tf::tree_knn<RandomIt> &knn) -> bool {
+  return knn.max_size() == 1;
+}
+
 template <typename Index, typename RealT, std::size_t N, typename F0,
-          typename F1, typename Result>
+          typename F1, typename Result, typename F2 = never_abort>
 auto tree_tree_proximity_sort(const tf::tree<Index, RealT, N> &tree0,
                               const tf::tree<Index, RealT, N> &tree1,
                               const F0 &aabb_dists_f, const F1 &closest_pts,
-                              Result &result) {
+                              Result &result, Index root0 = 0,
+                              Index root1 = 0, const F2 &abort = F2{}) {
   if (!tree0.nodes().size() || !tree1.nodes().size())
     return;
   struct holder_t {
@@ -23,11 +38,10 @@ auto tree_tree_proximity_sort(const tf::tree<Index, RealT, N> &tree0,
     Index id1;
   };
   tf::small_buffer<holder_t, 256> stack;
-  stack.push_back(holder_t{std::numeric_limits<float>::max(),
-                           std::numeric_limits<float>::max(), 0, 0});
 
   RealT aabb_min2 = result.metric();
   RealT aabb_min_max2 = result.metric();
+  const bool use_min_max = use_min_max_bound(result);
   const auto &nodes0 = tree0.nodes();
   const auto &nodes1 = tree1.nodes();
   const auto &ids0 = tree0.ids();
@@ -46,11 +60,16 @@ auto tree_tree_proximity_sort(const tf::tree<Index, RealT, N> &tree0,
     if (ds2.min_d2 > result.metric() || ds2.min_d2 > aabb_min_max2)
       return;
     aabb_min2 = std::min(ds2.min_d2, aabb_min2);
-    aabb_min_max2 = std::min(ds2.min_max_d2, aabb_min_max2);
+    if (use_min_max)
+      aabb_min_max2 = std::min(ds2.min_max_d2, aabb_min_max2);
     stack.push_back({ds2.min_d2, ds2.min_max_d2, id0, id1});
   };
+  // the root pair is subject to the same bounds (e.g. a search radius)
+  push_f(root0, root1);
 
   while (stack.size()) {
+    if (abort())
+      return;
     auto candidate = stack.back();
     stack.pop_back();
     if (candidate.min2 > result.metric() || candidate.min2 > aabb_min_max2)
@@ -88,11 +107,12 @@ auto tree_tree_proximity_sort(const tf::tree<Index, RealT, N> &tree0,
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
-          typename F1, typename Result>
+          typename F1, typename Result, typename F2 = never_abort>
 auto tree_tree_proximity_heap(const tf::tree<Index, RealT, N> &tree0,
                               const tf::tree<Index, RealT, N> &tree1,
                               const F0 &aabb_dists_f, const F1 &closest_pts,
-                              Result &result) {
+                              Result &result, Index root0 = 0,
+                              Index root1 = 0, const F2 &abort = F2{}) {
   if (!tree0.nodes().size() || !tree1.nodes().size())
     return;
   struct holder_t {
@@ -102,11 +122,10 @@ auto tree_tree_proximity_heap(const tf::tree<Index, RealT, N> &tree0,
     Index id1;
   };
   tf::small_buffer<holder_t, 256> heap;
-  heap.push_back(holder_t{std::numeric_limits<float>::max(),
-                          std::numeric_limits<float>::max(), 0, 0});
 
   RealT aabb_min2 = result.metric();
   RealT aabb_min_max2 = result.metric();
+  const bool use_min_max = use_min_max_bound(result);
   const auto &nodes0 = tree0.nodes();
   const auto &nodes1 = tree1.nodes();
   const auto &ids0 = tree0.ids();
@@ -122,12 +141,17 @@ auto tree_tree_proximity_heap(const tf::tree<Index, RealT, N> &tree0,
     if (ds2.min_d2 > result.metric() || ds2.min_d2 > aabb_min_max2)
       return;
     aabb_min2 = std::min(ds2.min_d2, aabb_min2);
-    aabb_min_max2 = std::min(ds2.min_max_d2, aabb_min_max2);
+    if (use_min_max)
+      aabb_min_max2 = std::min(ds2.min_max_d2, aabb_min_max2);
     heap.push_back({ds2.min_d2, ds2.min_max_d2, id0, id1});
     std::push_heap(heap.begin(), heap.end(), compare);
   };
+  // the root pair is subject to the same bounds (e.g. a search radius)
+  push_f(root0, root1);
 
   while (heap.size()) {
+    if (abort())
+      return;
     std::pop_heap(heap.begin(), heap.end(), compare);
     auto candidate = heap.back();
     heap.pop_back();
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "./aabb.hpp"
+#include "./ray.hpp"
 #include "./vector.hpp"
 #include "./vector_view.hpp"
 
@@ -146,5 +147,21 @@ auto intersects(const aabb<T, N> &box, const vector_view<T, N> &point,
   return intersects(point, box, epsilon);
 }
 
+/// @brief Check whether a ray intersects an AABB.
+///
+/// @return `true` if the primitives intersect; otherwise `false`.
+template <typename T, std::size_t N>
+auto intersects(const ray<T, N> &r, const aabb<T, N> &box) -> bool {
+  return ray_parameter(r, box) != std::numeric_limits<T>::infinity();
+}
+
+/// @brief Check whether a ray intersects an AABB.
+///
+/// @return `true` if the primitives intersect; otherwise `false`.
+template <typename T, std::size_t N>
+auto intersects(const aabb<T, N> &box, const ray<T, N> &r) -> bool {
+  return intersects(r, box);
+}
+
 } // namespace tf
 
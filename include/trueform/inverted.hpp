@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./transformation.hpp"
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace tf {
+
+/// @brief Compute the inverse of an affine transformation.
+///
+/// The linear part is inverted by Gauss-Jordan elimination with partial
+/// pivoting, and the translation is set so that the result undoes the input.
+/// The transformation must be invertible.
+///
+/// @tparam T Scalar type.
+/// @tparam Dims Dimensionality of the transformation.
+/// @param _this The transformation to invert.
+/// @return A new @ref tf::transformation that is the inverse of `_this`.
+template <typename T, std::size_t Dims>
+auto inverted(const transformation<T, Dims> &_this) -> transformation<T, Dims> {
+  std::array<std::array<T, 2 * Dims>, Dims> m;
+  for (std::size_t i = 0; i < Dims; ++i)
+    for (std::size_t j = 0; j < Dims; ++j) {
+      m[i][j] = _this(i, j);
+      m[i][Dims + j] = i == j;
+    }
+  for (std::size_t col = 0; col < Dims; ++col) {
+    auto pivot = col;
+    for (auto row = col + 1; row < Dims; ++row)
+      if (std::abs(m[row][col]) > std::abs(m[pivot][col]))
+        pivot = row;
+    std::swap(m[col], m[pivot]);
+    auto inv_p = 1 / m[col][col];
+    for (std::size_t j = 0; j < 2 * Dims; ++j)
+      m[col][j] *= inv_p;
+    for (std::size_t row = 0; row < Dims; ++row) {
+      if (row == col)
+        continue;
+      auto f = m[row][col];
+      for (std::size_t j = 0; j < 2 * Dims; ++j)
+        m[row][j] -= f * m[col][j];
+    }
+  }
+  transformation<T, Dims> out;
+  for (std::size_t i = 0; i < Dims; ++i) {
+    out(i, Dims) = 0;
+    for (std::size_t j = 0; j < Dims; ++j) {
+      out(i, j) = m[i][Dims + j];
+      out(i, Dims) -= m[i][Dims + j] * _this(j, Dims);
+    }
+  }
+  return out;
+}
+
+} // namespace tf
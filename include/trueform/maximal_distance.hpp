@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tf {
+
+/// @brief Computes the squared maximal distance between two AABBs.
+///
+/// Returns the largest squared Euclidean distance between any point of `a`
+/// and any point of `b`. Along each axis, this is the larger of the distances
+/// between opposite extremes of the two boxes.
+///
+/// @tparam T Numeric type.
+/// @tparam N Dimensionality of the AABB (e.g., 2D, 3D).
+/// @param a First AABB.
+/// @param b Second AABB.
+/// @return Maximal squared distance between points of `a` and `b`.
+template <typename T, std::size_t N>
+auto maximal_distance2(const aabb<T, N> &a, const aabb<T, N> &b) -> T {
+  T sum = T{};
+  for (std::size_t i = 0; i < N; ++i) {
+    T tmp = std::max(a.max[i] - b.min[i], b.max[i] - a.min[i]);
+    sum += tmp * tmp;
+  }
+  return sum;
+}
+
+/// @brief Computes the maximal distance between two AABBs.
+///
+/// This function returns the square root of the result of
+/// @ref maximal_distance2.
+///
+/// @tparam T Numeric type.
+/// @tparam N Dimensionality of the AABB (e.g., 2D, 3D).
+/// @param a First AABB.
+/// @param b Second AABB.
+/// @return Maximal distance between points of `a` and `b`.
+template <typename T, std::size_t N>
+auto maximal_distance(const aabb<T, N> &a, const aabb<T, N> &b) -> T {
+  return std::sqrt(maximal_distance2(a, b));
+}
+
+} // namespace tf
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./implementation/collect_pairs.hpp"
+#include "./implementation/stitch_segments.hpp"
+#include "./intersects.hpp"
+#include "./mod_tree.hpp"
+#include "./offset_block_range.hpp"
+#include "./orient3d.hpp"
+#include "./search.hpp"
+#include "./tree.hpp"
+#include "./vector.hpp"
+#include <algorithm>
+#include <array>
+
+namespace tf {
+
+/// @brief Polylines stored as flat buffers of points and offsets.
+///
+/// Polyline `i` consists of `points[offsets[i]]` to `points[offsets[i + 1]]`
+/// (exclusive). A closed polyline repeats its first point at the end. Use
+/// @ref tf::make_offset_block_range (or `polylines()`) to iterate over them.
+///
+/// @tparam Index The type of the offsets.
+/// @tparam RealT The scalar coordinate type.
+template <typename Index, typename RealT> struct intersection_curves {
+  tf::buffer<tf::vector<RealT, 3>> points;
+  tf::buffer<Index> offsets;
+
+  /// @brief A range of polylines, each a range of points.
+  auto polylines() const { return tf::make_offset_block_range(offsets, points); }
+};
+
+} // namespace tf
+
+namespace tf::implementation {
+
+// Computes the segment in which two triangles cross. Each endpoint is where
+// an edge of one triangle crosses the other, and is keyed by
+// `{mesh of the edge, edge vertex, edge vertex, face of the other mesh}`, so
+// that the segments of neighbouring faces share keys. Coplanar pairs and
+// contacts through vertices have no such edge crossings and are skipped.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2, typename Range3>
+auto triangle_pair_segment(Index face0, const Range0 &triangles0,
+                           const Range1 &points0, Index face1,
+                           const Range2 &triangles1, const Range3 &points1,
+                           keyed_segment<Index, tf::vector<RealT, 3>> &segment)
+    -> bool {
+  using point_t = std::array<double, 3>;
+  std::array<Index, 3> vertices[2];
+  point_t pts[2][3];
+  for (int i = 0; i < 3; ++i) {
+    vertices[0][i] = triangles0[face0][i];
+    vertices[1][i] = triangles1[face1][i];
+    const auto &pt0 = points0[vertices[0][i]];
+    const auto &pt1 = points1[vertices[1][i]];
+    pts[0][i] = {double(pt0[0]), double(pt0[1]), double(pt0[2])};
+    pts[1][i] = {double(pt1[0]), double(pt1[1]), double(pt1[2])};
+  }
+  int sides[2][3];
+  for (int m = 0; m < 2; ++m) {
+    const auto &other = pts[1 - m];
+    for (int i = 0; i < 3; ++i)
+      sides[m][i] = tf::orient3d(pts[m][i], other[0], other[1], other[2]);
+    if (sides[m][0] == sides[m][1] && sides[m][0] == sides[m][2])
+      return false;
+  }
+  Index faces[2] = {face0, face1};
+  std::array<Index, 4> keys[4];
+  tf::vector<RealT, 3> crossings[4];
+  int n_crossings = 0;
+  for (int m = 0; m < 2; ++m) {
+    const auto &other = pts[1 - m];
+    for (int i = 0; i < 3; ++i) {
+      int i0 = i, i1 = (i + 1) % 3;
+      if (sides[m][i0] * sides[m][i1] >= 0)
+        continue;
+      // the edge is oriented by vertex index, so that both faces of the
+      // edge compute the same crossing point
+      if (vertices[m][i1] < vertices[m][i0])
+        std::swap(i0, i1);
+      const auto &a = pts[m][i0];
+      const auto &b = pts[m][i1];
+      int o0 = tf::orient3d(a, b, other[0], other[1]);
+      int o1 = tf::orient3d(a, b, other[1], other[2]);
+      int o2 = tf::orient3d(a, b, other[2], other[0]);
+      bool crosses = !((o0 < 0 || o1 < 0 || o2 < 0) &&
+                       (o0 > 0 || o1 > 0 || o2 > 0));
+      if (crosses && n_crossings < 4) {
+        point_t e0, e1, ea, eb;
+        for (int d = 0; d < 3; ++d) {
+          e0[d] = other[1][d] - other[0][d];
+          e1[d] = other[2][d] - other[0][d];
+          ea[d] = a[d] - other[0][d];
+          eb[d] = b[d] - other[0][d];
+        }
+        point_t normal = {e0[1] * e1[2] - e0[2] * e1[1],
+                          e0[2] * e1[0] - e0[0] * e1[2],
+                          e0[0] * e1[1] - e0[1] * e1[0]};
+        double da = normal[0] * ea[0] + normal[1] * ea[1] + normal[2] * ea[2];
+        double db = normal[0] * eb[0] + normal[1] * eb[1] + normal[2] * eb[2];
+        double den = da - db;
+        double t = den != 0 ? std::clamp(da / den, 0.0, 1.0) : 0.5;
+        for (int d = 0; d < 3; ++d)
+          crossings[n_crossings][d] = RealT(a[d] + t * (b[d] - a[d]));
+        keys[n_crossings] = {Index(m), vertices[m][i0], vertices[m][i1],
+                             faces[1 - m]};
+        ++n_crossings;
+      }
+    }
+  }
+  if (n_crossings < 2)
+    return false;
+  // an edge through an edge is found from both triangles, keep the two
+  // crossings farthest apart
+  int best0 = 0, best1 = 1;
+  RealT best = -1;
+  for (int i = 0; i < n_crossings; ++i)
+    for (int j = i + 1; j < n_crossings; ++j) {
+      auto d2 = (crossings[i] - crossings[j]).length2();
+      if (d2 > best) {
+        best = d2;
+        best0 = i;
+        best1 = j;
+      }
+    }
+  segment.keys = {keys[best0], keys[best1]};
+  segment.points = {crossings[best0], crossings[best1]};
+  return true;
+}
+
+template <typename Index, typename RealT, typename Tree0, typename Range0,
+          typename Range1, typename Tree1, typename Range2, typename Range3>
+auto mesh_intersection_curves(const Tree0 &tree0, const Range0 &triangles0,
+                              const Range1 &points0, const Tree1 &tree1,
+                              const Range2 &triangles1, const Range3 &points1,
+                              int paralelism_depth)
+    -> tf::intersection_curves<Index, RealT> {
+  using segment_t = keyed_segment<Index, tf::vector<RealT, 3>>;
+  auto segments = collect_values<segment_t>([&](const auto &push) {
+    tf::search(
+        tree0, tree1,
+        [](const auto &aabb0, const auto &aabb1) {
+          return tf::intersects(aabb0, aabb1);
+        },
+        [&](Index face0, Index face1) {
+          segment_t segment;
+          if (triangle_pair_segment<Index, RealT>(face0, triangles0, points0,
+                                                  face1, triangles1, points1,
+                                                  segment))
+            push(segment);
+          return false;
+        },
+        [] { return false; }, paralelism_depth);
+  });
+  tf::intersection_curves<Index, RealT> out;
+  stitch_segments(segments, out.points, out.offsets);
+  return out;
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Compute the curves along which two triangle meshes intersect.
+///
+/// Runs a parallel search (see @ref tf::search) between trees built over
+/// the triangles of each mesh. Each pair of crossing triangles contributes
+/// the segment in which they cross, computed with the exact
+/// @ref tf::orient3d predicate and collected into thread-local buffers. An
+/// endpoint of a segment is where an edge of one mesh crosses a face of the
+/// other, so segments of neighbouring faces share endpoints. These are
+/// joined in parallel through a lock-free hash table, and the joined
+/// segments are walked into polylines.
+///
+/// Coplanar triangle pairs and contacts through vertices are not reported.
+/// Curves through such configurations are split into several polylines.
+///
+/// @param tree0 The spatial tree built over `triangles0`.
+/// @param triangles0 A range of triangles, each a range of three point
+/// indices.
+/// @param points0 The points indexed by `triangles0`.
+/// @param tree1 The spatial tree built over `triangles1`.
+/// @param triangles1 A range of triangles, each a range of three point
+/// indices.
+/// @param points1 The points indexed by `triangles1`.
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::intersection_curves<Index, RealT> with the polylines.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2, typename Range3>
+auto mesh_intersection_curves(const tf::tree<Index, RealT, 3> &tree0,
+                              const Range0 &triangles0, const Range1 &points0,
+                              const tf::tree<Index, RealT, 3> &tree1,
+                              const Range2 &triangles1, const Range3 &points1,
+                              int paralelism_depth = 6)
+    -> tf::intersection_curves<Index, RealT> {
+  return tf::implementation::mesh_intersection_curves<Index, RealT>(
+      tree0, triangles0, points0, tree1, triangles1, points1,
+      paralelism_depth);
+}
+
+/// @brief Compute the curves along which two triangle meshes intersect.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::intersection_curves<Index, RealT> with the polylines.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2, typename Range3>
+auto mesh_intersection_curves(const tf::mod_tree<Index, RealT, 3> &tree0,
+                              const Range0 &triangles0, const Range1 &points0,
+                              const tf::tree<Index, RealT, 3> &tree1,
+                              const Range2 &triangles1, const Range3 &points1,
+                              int paralelism_depth = 6)
+    -> tf::intersection_curves<Index, RealT> {
+  return tf::implementation::mesh_intersection_curves<Index, RealT>(
+      tree0, triangles0, points0, tree1, triangles1, points1,
+      paralelism_depth);
+}
+
+/// @brief Compute the curves along which two triangle meshes intersect.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::intersection_curves<Index, RealT> with the polylines.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2, typename Range3>
+auto mesh_intersection_curves(const tf::tree<Index, RealT, 3> &tree0,
+                              const Range0 &triangles0, const Range1 &points0,
+                              const tf::mod_tree<Index, RealT, 3> &tree1,
+                              const Range2 &triangles1, const Range3 &points1,
+                              int paralelism_depth = 6)
+    -> tf::intersection_curves<Index, RealT> {
+  return tf::implementation::mesh_intersection_curves<Index, RealT>(
+      tree0, triangles0, points0, tree1, triangles1, points1,
+      paralelism_depth);
+}
+
+/// @brief Compute the curves along which two triangle meshes intersect.
+///
+/// Searches the main and the delta trees. See the `tf::tree` overload.
+///
+/// @return tf::intersection_curves<Index, RealT> with the polylines.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2, typename Range3>
+auto mesh_intersection_curves(const tf::mod_tree<Index, RealT, 3> &tree0,
+                              const Range0 &triangles0, const Range1 &points0,
+                              const tf::mod_tree<Index, RealT, 3> &tree1,
+                              const Range2 &triangles1, const Range3 &points1,
+                              int paralelism_depth = 6)
+    -> tf::intersection_curves<Index, RealT> {
+  return tf::implementation::mesh_intersection_curves<Index, RealT>(
+      tree0, triangles0, points0, tree1, triangles1, points1,
+      paralelism_depth);
+}
+
+} // namespace tf
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./closest_feature_on_triangle.hpp"
+#include "./dot.hpp"
+#include "./vector.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace tf::implementation {
+
+template <typename RealT>
+auto pseudonormal_cross(const tf::vector<RealT, 3> &a,
+                        const tf::vector<RealT, 3> &b) -> tf::vector<RealT, 3> {
+  return tf::make_vector<RealT, 3>({a[1] * b[2] - a[2] * b[1],
+                                    a[2] * b[0] - a[0] * b[2],
+                                    a[0] * b[1] - a[1] * b[0]});
+}
+
+template <typename RealT>
+auto normalized_or_zero(tf::vector<RealT, 3> v) -> tf::vector<RealT, 3> {
+  auto length = v.length();
+  if (length > 0)
+    v *= 1 / length;
+  return v;
+}
+
+// Sorts `{key, ..., corner}` records and calls `f(begin, end)` for each
+// group of records with equal keys, in parallel.
+template <typename Record, typename F>
+auto for_each_sorted_group(tf::buffer<Record> &records, const F &f) -> void {
+  tbb::parallel_sort(records.begin(), records.end());
+  auto same_key = [](const Record &a, const Record &b) {
+    return std::equal(a.begin(), a.end() - 1, b.begin());
+  };
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, records.size()),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          if (i && same_key(records[i - 1], records[i]))
+            continue;
+          auto end = i + 1;
+          while (end < records.size() && same_key(records[i], records[end]))
+            ++end;
+          f(records.begin() + i, records.begin() + end);
+        }
+      });
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Angle-weighted pseudonormals of a triangle mesh.
+///
+/// Stores unit face normals, angle-weighted vertex pseudonormals and edge
+/// pseudonormals (the sum of the normals of the faces of an edge), as
+/// introduced by Bærentzen and Aanæs, "Signed Distance Computation Using
+/// the Angle Weighted Pseudonormal". For a closed, consistently oriented
+/// mesh, the sign of `(query - closest) · n`, where `n` is the pseudonormal
+/// of the feature that the closest point lies on, is the side of the
+/// surface the query is on. This holds at edges and vertices too, where the
+/// face normal is ambiguous.
+///
+/// All normals are computed in parallel. Edges are matched by sorting the
+/// corners of the faces.
+///
+/// @tparam Index The type used for vertex and face identifiers.
+/// @tparam RealT The real-valued coordinate type.
+template <typename Index, typename RealT> class mesh_pseudonormals {
+public:
+  /// @brief Compute the pseudonormals of a mesh.
+  ///
+  /// @param triangles A range of triangles, each a range of three point
+  /// indices.
+  /// @param points The points indexed by the triangles.
+  template <typename Range0, typename Range1>
+  auto build(const Range0 &triangles, const Range1 &points) -> void {
+    using vector_t = tf::vector<RealT, 3>;
+    std::size_t n_faces = triangles.size();
+    auto point = [&points](Index id) {
+      const auto &pt = points[id];
+      return tf::make_vector<RealT, 3>(
+          {RealT(pt[0]), RealT(pt[1]), RealT(pt[2])});
+    };
+    _face_normals.allocate(n_faces);
+    _edge_normals.allocate(3 * n_faces);
+    _vertex_normals.allocate(points.size());
+    // corners are stored as {vertex, corner} and edges as
+    // {min vertex, max vertex, corner}, for matching by sorting
+    tf::buffer<std::array<Index, 2>> corners;
+    corners.allocate(3 * n_faces);
+    tf::buffer<std::array<Index, 3>> edges;
+    edges.allocate(3 * n_faces);
+    tf::buffer<RealT> angles;
+    angles.allocate(3 * n_faces);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, n_faces),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+          for (auto face = range.begin(); face < range.end(); ++face) {
+            const auto &t = triangles[face];
+            vector_t pts[3] = {point(t[0]), point(t[1]), point(t[2])};
+            _face_normals[face] = implementation::normalized_or_zero(
+                implementation::pseudonormal_cross(pts[1] - pts[0],
+                                                   pts[2] - pts[0]));
+            for (int i = 0; i < 3; ++i) {
+              Index corner = Index(3 * face + i);
+              auto e0 = pts[(i + 1) % 3] - pts[i];
+              auto e1 = pts[(i + 2) % 3] - pts[i];
+              angles[corner] = std::atan2(
+                  implementation::pseudonormal_cross(e0, e1).length(),
+                  tf::dot(e0, e1));
+              corners[corner] = {Index(t[i]), corner};
+              Index v0 = t[i], v1 = t[(i + 1) % 3];
+              edges[corner] = {std::min(v0, v1), std::max(v0, v1), corner};
+            }
+          }
+        });
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, points.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                        for (auto i = range.begin(); i < range.end(); ++i)
+                          _vertex_normals[i] =
+                              tf::make_vector<RealT, 3>({0, 0, 0});
+                      });
+    implementation::for_each_sorted_group(corners, [&](auto begin, auto end) {
+      auto normal = tf::make_vector<RealT, 3>({0, 0, 0});
+      for (auto it = begin; it != end; ++it)
+        normal += _face_normals[(*it)[1] / 3] * angles[(*it)[1]];
+      _vertex_normals[(*begin)[0]] = implementation::normalized_or_zero(normal);
+    });
+    implementation::for_each_sorted_group(edges, [&](auto begin, auto end) {
+      auto normal = tf::make_vector<RealT, 3>({0, 0, 0});
+      for (auto it = begin; it != end; ++it)
+        normal += _face_normals[(*it)[2] / 3];
+      normal = implementation::normalized_or_zero(normal);
+      for (auto it = begin; it != end; ++it)
+        _edge_normals[(*it)[2]] = normal;
+    });
+  }
+
+  /// @brief The pseudonormal of a feature of a face.
+  ///
+  /// @param triangles The triangles the pseudonormals were built for.
+  /// @param face The face.
+  /// @param feature The feature of the face, as returned by
+  /// @ref tf::closest_feature_on_triangle.
+  template <typename Range>
+  auto normal(const Range &triangles, Index face,
+              const tf::closest_feature<RealT> &feature) const
+      -> const tf::vector<RealT, 3> & {
+    switch (feature.feature) {
+    case tf::triangle_feature::vertex:
+      return _vertex_normals[triangles[face][feature.id]];
+    case tf::triangle_feature::edge:
+      return _edge_normals[3 * face + feature.id];
+    default:
+      return _face_normals[face];
+    }
+  }
+
+  /// @brief The unit normals of the faces.
+  auto face_normals() const -> const tf::buffer<tf::vector<RealT, 3>> & {
+    return _face_normals;
+  }
+
+  /// @brief The pseudonormals of the edges, `3 * face + i` for the edge
+  /// from vertex `i` to vertex `(i + 1) % 3` of a face.
+  auto edge_normals() const -> const tf::buffer<tf::vector<RealT, 3>> & {
+    return _edge_normals;
+  }
+
+  /// @brief The angle-weighted pseudonormals of the vertices.
+  auto vertex_normals() const -> const tf::buffer<tf::vector<RealT, 3>> & {
+    return _vertex_normals;
+  }
+
+private:
+  tf::buffer<tf::vector<RealT, 3>> _face_normals;
+  tf::buffer<tf::vector<RealT, 3>> _edge_normals;
+  tf::buffer<tf::vector<RealT, 3>> _vertex_normals;
+};
+
+} // namespace tf
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./indirect_range.hpp"
+#include "./intersects.hpp"
+#include "./mod_tree.hpp"
+#include "./search_self_collect.hpp"
+#include "./tree.hpp"
+#include "./triangle_triangle_intersects.hpp"
+#include <array>
+
+namespace tf::implementation {
+template <typename Tree, typename Range0, typename Range1>
+auto mesh_self_intersections(const Tree &tree, const Range0 &triangles,
+                             const Range1 &points, int paralelism_depth) {
+  return tf::search_self_collect(
+      tf::strategy::sorted, tree,
+      [](const auto &aabb0, const auto &aabb1) {
+        return tf::intersects(aabb0, aabb1);
+      },
+      [&](auto id0, auto id1) {
+        const auto &triangle0 = triangles[id0];
+        const auto &triangle1 = triangles[id1];
+        // neighbours always touch along the shared vertex or edge
+        for (int i = 0; i < 3; ++i)
+          for (int j = 0; j < 3; ++j)
+            if (triangle0[i] == triangle1[j])
+              return false;
+        return tf::triangle_triangle_intersects(
+            tf::make_indirect_range(triangle0, points),
+            tf::make_indirect_range(triangle1, points));
+      },
+      paralelism_depth);
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Find all pairs of intersecting triangles of a mesh, in parallel.
+///
+/// Runs a self search (see @ref tf::search_self_collect) over a tree built
+/// on the triangles, with overlapping AABBs as the broad phase and
+/// @ref tf::triangle_triangle_intersects as the exact narrow phase. Pairs of
+/// triangles that share a vertex index are skipped, as they touch by
+/// construction. Pairs are collected into thread-local buffers.
+///
+/// Pairs are stored as `{min(id0, id1), max(id0, id1)}` and sorted
+/// lexicographically, making the result deterministic.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` triangle pairs.
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto mesh_self_intersections(const tf::tree<Index, RealT, 3> &tree,
+                             const Range0 &triangles, const Range1 &points,
+                             int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::mesh_self_intersections(tree, triangles, points,
+                                                     paralelism_depth);
+}
+
+/// @brief Find all pairs of intersecting triangles of a mesh, in parallel.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` triangle pairs.
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto mesh_self_intersections(const tf::mod_tree<Index, RealT, 3> &tree,
+                             const Range0 &triangles, const Range1 &points,
+                             int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::mesh_self_intersections(tree, triangles, points,
+                                                     paralelism_depth);
+}
+
+} // namespace tf
@@ -44,7 +44,7 @@ public:
   auto build(const Range &objects, const tf::tree_config<FC> &config) -> void {
     _delta_ids.clear();
     _delta_tree.clear();
-    _main_tree.build(objects, make_aabb, config);
+    _main_tree.template build<Partitioner>(objects, config);
   }
 
   /**
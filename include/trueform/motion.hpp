@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./aabb_union.hpp"
+#include "./transformation.hpp"
+#include "./transformed.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tf {
+
+/// @brief The motion of a tree between two poses over a time step.
+///
+/// Time runs over `[0, 1]`. Every point moves linearly from its position
+/// under `from()` to its position under `to()`, so that the pose at time
+/// `t` is the affine blend `at(t) = (1 - t) * from() + t * to()`. This is
+/// the usual linear motion model of continuous collision detection. It
+/// matches rigid motion for translations, and for small rotations per step.
+///
+/// Under this model, a box moves into the blend of its boxes at the end
+/// poses. The union of the two is a conservative swept bound.
+///
+/// Use `tf::make_motion` to create an instance.
+///
+/// @tparam RealT The scalar coordinate type.
+/// @tparam Dims The spatial dimension.
+template <typename RealT, std::size_t Dims> class motion {
+public:
+  motion(const tf::transformation<RealT, Dims> &from,
+         const tf::transformation<RealT, Dims> &to)
+      : _from{from}, _to{to} {}
+
+  /// @brief The pose at time `0`.
+  auto from() const -> const tf::transformation<RealT, Dims> & {
+    return _from;
+  }
+
+  /// @brief The pose at time `1`.
+  auto to() const -> const tf::transformation<RealT, Dims> & { return _to; }
+
+  /// @brief The (affine) pose at time `t`.
+  auto at(RealT t) const -> tf::transformation<RealT, Dims> {
+    tf::transformation<RealT, Dims> out;
+    for (std::size_t i = 0; i < Dims; ++i)
+      for (std::size_t j = 0; j < Dims + 1; ++j)
+        out(i, j) = (1 - t) * _from(i, j) + t * _to(i, j);
+    return out;
+  }
+
+  /// @brief The box swept by a local box over the time step.
+  auto swept(const tf::aabb<RealT, Dims> &aabb) const
+      -> tf::aabb<RealT, Dims> {
+    return tf::aabb_union(tf::transformed(aabb, _from),
+                          tf::transformed(aabb, _to));
+  }
+
+  /// @brief The largest distance travelled by a point of a local box over
+  /// the time step.
+  ///
+  /// Points move at constant velocity, so this bounds their speed. The
+  /// displacement is convex over the box, and maximal at a corner.
+  auto max_displacement(const tf::aabb<RealT, Dims> &aabb) const -> RealT {
+    RealT out = 0;
+    for (std::size_t corner = 0; corner < (std::size_t(1) << Dims);
+         ++corner) {
+      RealT length2 = 0;
+      for (std::size_t i = 0; i < Dims; ++i) {
+        auto d = _to(i, Dims) - _from(i, Dims);
+        for (std::size_t j = 0; j < Dims; ++j)
+          d += (_to(i, j) - _from(i, j)) *
+               ((corner >> j) & 1 ? aabb.max[j] : aabb.min[j]);
+        length2 += d * d;
+      }
+      out = std::max(out, length2);
+    }
+    return std::sqrt(out);
+  }
+
+private:
+  tf::transformation<RealT, Dims> _from;
+  tf::transformation<RealT, Dims> _to;
+};
+
+/// @brief Create the motion between two poses.
+///
+/// @param from The pose at time `0`.
+/// @param to The pose at time `1`.
+/// @return A `tf::motion` instance.
+template <typename RealT, std::size_t Dims>
+auto make_motion(const tf::transformation<RealT, Dims> &from,
+                 const tf::transformation<RealT, Dims> &to)
+    -> motion<RealT, Dims> {
+  return motion<RealT, Dims>{from, to};
+}
+
+/// @brief Create the motion of a tree that stays in place.
+///
+/// @param pose The pose over the whole time step.
+/// @return A `tf::motion` instance.
+template <typename RealT, std::size_t Dims>
+auto make_motion(const tf::transformation<RealT, Dims> &pose)
+    -> motion<RealT, Dims> {
+  return motion<RealT, Dims>{pose, pose};
+}
+
+} // namespace tf
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./tree_closest_point.hpp"
+
+namespace tf {
+
+/// @brief A primitive hint used to warm-start a nearness query.
+///
+/// When a query is repeated for a slowly moving target (e.g. a tracked probe),
+/// the previous result is usually close to the new one. Passing it as a hint
+/// to @ref tf::nearness_search evaluates that primitive first, so the traversal
+/// starts with a tight bound and prunes nearly all nodes that are not on the
+/// way to the new closest primitive. The result is the same as without a hint.
+///
+/// An empty hint (`element == no_id`) is ignored.
+///
+/// Use `tf::make_nearness_hint` to create an instance.
+///
+/// @tparam Index The type used for primitive identifiers.
+template <typename Index> struct nearness_hint {
+  static constexpr Index no_id = -1;
+  Index element{no_id};
+
+  operator bool() const { return element != no_id; }
+};
+
+/// @brief Create a nearness hint from a primitive id.
+///
+/// @param element The id of the primitive to evaluate first.
+/// @return A `tf::nearness_hint` instance.
+template <typename Index>
+auto make_nearness_hint(Index element) -> nearness_hint<Index> {
+  return nearness_hint<Index>{element};
+}
+
+/// @brief Create a nearness hint from a previous query result.
+///
+/// An empty result produces an empty hint.
+///
+/// @param result The result of a previous @ref tf::nearness_search.
+/// @return A `tf::nearness_hint` instance.
+template <typename Index, typename RealT, std::size_t Dims>
+auto make_nearness_hint(
+    const tf::tree_closest_point<Index, RealT, Dims> &result)
+    -> nearness_hint<Index> {
+  return nearness_hint<Index>{result.element};
+}
+
+} // namespace tf
+
+namespace tf::implementation {
+// Evaluates the hinted primitive into `result`, so that the traversal that
+// follows starts with its bound. An empty hint is ignored.
+template <typename Index, typename Result, typename F>
+auto warm_start(const tf::nearness_hint<Index> &hint, Result &result,
+                const F &closest_point_f) -> void {
+  if (hint)
+    result.update(hint.element, closest_point_f(hint.element));
+}
+
+// The leaf callback of a warm-started query. It evaluates the primitives of
+// a leaf, except for the hinted one, which `warm_start` already evaluated.
+template <typename Index, typename F>
+auto hinted_leaf_f(const tf::nearness_hint<Index> &hint,
+                   const F &closest_point_f) {
+  return [hint, &closest_point_f](const auto &ids, auto &result) {
+    for (const auto &id : ids)
+      if (id != hint.element)
+        result.update(id, closest_point_f(id));
+  };
+}
+} // namespace tf::implementation
@@ -5,11 +5,18 @@
  */
 #pragma once
 
+#include "./approximation.hpp"
+#include "./distance.hpp"
+#include "./implementation/approximate_result.hpp"
 #include "./implementation/tree_closest_point.hpp"
 #include "./implementation/tree_closest_point_pair.hpp"
 #include "./implementation/tree_closest_point_using_sort_by_level.hpp"
+#include "./implementation/tree_nearness_parallel.hpp"
 #include "./implementation/tree_tree_proximity.hpp"
 #include "./mod_tree.hpp"
+#include "./nearness_hint.hpp"
+#include "./query_budget.hpp"
+#include "./transformed_tree.hpp"
 #include "./tree.hpp"
 #include "./tree_knn.hpp"
 
@@ -20,6 +27,8 @@ struct top_k_sorted_t {};
 static constexpr top_k_sorted_t top_k_sorted;
 struct priority_queue_t {};
 static constexpr priority_queue_t priority_queue;
+struct parallel_t {};
+static constexpr parallel_t parallel;
 } // namespace strategy
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -715,6 +724,7 @@ auto nearness_search(strategy::top_k_sorted_t,
                      tf::tree_knn<RandomIt> &knn) {
   tf::implementation::tree_closest_point_using_sort_by_level(
       tree.nodes(), tree.ids(), aabb_metric, closest_point_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -729,6 +739,7 @@ auto nearness_search(strategy::top_k_sorted_t,
   tf::implementation::tree_closest_point_using_sort_by_level(
       tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
       closest_point_f, knn);
+  knn.finalize();
 }
 
 /// @brief Perform a knn spatial query against a single tree structure.
@@ -785,6 +796,7 @@ auto nearness_search(strategy::priority_queue_t,
                      tf::tree_knn<RandomIt> &knn) {
   tf::implementation::tree_closest_point_using_heap(
       tree.nodes(), tree.ids(), aabb_metric, closest_point_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -799,6 +811,7 @@ auto nearness_search(strategy::priority_queue_t,
   tf::implementation::tree_closest_point_using_heap(
       tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
       closest_point_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -810,6 +823,7 @@ auto nearness_search(strategy::top_k_sorted_t,
                      tree_knn<RandomIt> &knn) {
   tf::implementation::tree_tree_proximity_sort(tree0, tree1, aabb_metrics_f,
                                                closest_points_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -831,6 +845,7 @@ auto nearness_search(strategy::top_k_sorted_t,
   tf::implementation::tree_tree_proximity_sort(
       tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
       knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -844,6 +859,7 @@ auto nearness_search(strategy::top_k_sorted_t,
       tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, knn);
   tf::implementation::tree_tree_proximity_sort(
       tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -857,12 +873,14 @@ auto nearness_search(strategy::top_k_sorted_t,
       tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, knn);
   tf::implementation::tree_tree_proximity_sort(
       tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, knn);
+  knn.finalize();
 }
 
-/// @brief Perform a knn spatial query between two tree structures.
+/// @brief Perform a k-nearest-pairs spatial query between two tree structures.
 ///
-/// Traverses both trees in tandem to find the k nearest pairs of primitives between them,
-/// using user-provided AABB distance and primitive distance callbacks. 
+/// Traverses both trees in tandem to find the `k` closest pairs of primitives
+/// between them. Node pairs are pruned against the current k-th best metric
+/// (or the search radius of `knn`, until `k` pairs have been found).
 ///
 /// @param tree0 The first spatial tree to query.
 /// @param tree1 The second spatial tree to query.
@@ -870,9 +888,8 @@ auto nearness_search(strategy::top_k_sorted_t,
 ///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
 /// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
 ///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
-/// @param knn The accumulator `tf::tree_knn` for the query
-///
-/// @return tf::tree_closest_point_pair<Index, RealT, N>.
+/// @param knn A @ref tf::tree_knn over a user buffer of `tf::tree_closest_point_pair<Index, RealT, N>`.
+///            Use @ref tf::make_tree_knn to create it, optionally with a search radius.
 template <typename Index, typename RealT, std::size_t N, typename F0,
           typename F1, typename RandomIt>
 auto nearness_search(const tf::tree<Index, RealT, N> &tree0,
@@ -964,6 +981,7 @@ auto nearness_search(strategy::priority_queue_t,
                      tree_knn<RandomIt> &knn) {
   tf::implementation::tree_tree_proximity_heap(tree0, tree1, aabb_metrics_f,
                                                closest_points_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -985,6 +1003,7 @@ auto nearness_search(strategy::priority_queue_t,
   tf::implementation::tree_tree_proximity_heap(
       tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
       knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -998,6 +1017,7 @@ auto nearness_search(strategy::priority_queue_t,
       tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, knn);
   tf::implementation::tree_tree_proximity_heap(
       tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, knn);
+  knn.finalize();
 }
 
 template <typename Index, typename RealT, std::size_t N, typename F0,
@@ -1011,6 +1031,1499 @@ auto nearness_search(strategy::priority_queue_t,
       tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, knn);
   tf::implementation::tree_tree_proximity_heap(
       tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, knn);
+  knn.finalize();
+}
+
+// parallel
+//
+// The radius of the parallel overloads is not deduced, so that a radius
+// of a different type is not silently converted to the parallelism depth.
+
+/// @brief Perform a nearest-point spatial query against a single tree structure, in parallel.
+///
+/// The top `paralelism_depth` levels of the tree are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune nodes, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, subtrees are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_parallel(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result,
+      paralelism_depth);
+  return result.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_parallel(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth);
+  tf::implementation::tree_closest_point_parallel(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth);
+  return result.point;
+}
+
+/// @brief Perform a nearest-point spatial query against a single tree structure, in parallel.
+///
+/// The top `paralelism_depth` levels of the tree are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune nodes, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, subtrees are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius for the query
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{radius *
+                                                                 radius};
+  tf::implementation::tree_closest_point_parallel(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result,
+      paralelism_depth);
+  return result.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{radius *
+                                                                 radius};
+  tf::implementation::tree_closest_point_parallel(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth);
+  tf::implementation::tree_closest_point_parallel(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth);
+  return result.point;
+}
+
+/// @brief Perform a nearest-point spatial query against a single tree structure, in parallel.
+///
+/// The top `paralelism_depth` levels of the tree are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune nodes, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, subtrees are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point_parallel(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, knn,
+      paralelism_depth);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point_parallel(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, knn, paralelism_depth);
+  tf::implementation::tree_closest_point_parallel(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, knn, paralelism_depth);
+  knn.finalize();
+}
+
+/// @brief Perform a nearest-pair spatial query between two tree structures, in parallel.
+///
+/// Node pairs of the top `paralelism_depth` levels are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune node pairs, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, node pairs are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1, aabb_metrics_f, closest_points_f, result, paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  return result.points;
+}
+
+/// @brief Perform a nearest-pair spatial query between two tree structures, in parallel.
+///
+/// Node pairs of the top `paralelism_depth` levels are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune node pairs, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, node pairs are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param radius The search radius for the query
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      radius * radius};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1, aabb_metrics_f, closest_points_f, result, paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      radius * radius};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      radius * radius};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     std::common_type_t<RealT> radius,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      radius * radius};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth);
+  return result.points;
+}
+
+/// @brief Perform a nearest-pair spatial query between two tree structures, in parallel.
+///
+/// Node pairs of the top `paralelism_depth` levels are split into tasks. Tasks
+/// share an atomically tightened bound, which they use to prune node pairs, and
+/// accumulate into thread-local results that are merged at the end.
+/// Below that depth, node pairs are searched serially, using the top-k sorted
+/// traversal strategy.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1, aabb_metrics_f, closest_points_f, knn, paralelism_depth);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth);
+  knn.finalize();
+}
+
+// budgeted
+
+/// @brief Perform a budgeted nearest-point query against a single tree structure.
+///
+/// The traversal stops when `budget` is exhausted, returning the best result
+/// found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result, Index(0),
+      budget);
+  return result.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  return result.point;
+}
+
+/// @brief Perform a budgeted knn query against a single tree structure.
+///
+/// The traversal stops when `budget` is exhausted, returning the best result
+/// found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, knn, Index(0),
+      budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, knn, Index(0), budget);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, knn, Index(0), budget);
+  knn.finalize();
+}
+
+/// @brief Perform a budgeted nearest-pair query between two tree structures.
+///
+/// The traversal stops when `budget` is exhausted, returning the best result
+/// found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1, aabb_metrics_f, closest_points_f, result, Index(0),
+      Index(0), budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, Index(0), Index(0), budget);
+  return result.points;
+}
+
+/// @brief Perform a budgeted k-nearest-pairs query between two tree structures.
+///
+/// The traversal stops when `budget` is exhausted, returning the best result
+/// found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget) {
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1, aabb_metrics_f, closest_points_f, knn, Index(0),
+      Index(0), budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget) {
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, Index(0), Index(0), budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, result,
+      Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, result,
+      Index(0), Index(0), budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      Index(0), Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      Index(0), Index(0), budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget) {
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, knn, Index(0),
+      Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, knn,
+      Index(0), Index(0), budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget) {
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, knn, Index(0),
+      Index(0), budget);
+  tf::implementation::tree_tree_proximity_sort(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, knn,
+      Index(0), Index(0), budget);
+  knn.finalize();
+}
+
+/// @brief Perform a budgeted nearest-point query against a single tree structure, in parallel.
+///
+/// Tasks share `budget`, and stop when it is exhausted, returning the best
+/// result found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_parallel(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result,
+      paralelism_depth, budget);
+  return result.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_parallel(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth, budget);
+  tf::implementation::tree_closest_point_parallel(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, paralelism_depth, budget);
+  return result.point;
+}
+
+/// @brief Perform a budgeted knn query against a single tree structure, in parallel.
+///
+/// Tasks share `budget`, and stop when it is exhausted, returning the best
+/// result found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point_parallel(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, knn,
+      paralelism_depth, budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 4) {
+  tf::implementation::tree_closest_point_parallel(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, knn, paralelism_depth, budget);
+  tf::implementation::tree_closest_point_parallel(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, knn, paralelism_depth, budget);
+  knn.finalize();
+}
+
+/// @brief Perform a budgeted nearest-pair query between two tree structures, in parallel.
+///
+/// Tasks share `budget`, and stop when it is exhausted, returning the best
+/// result found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+///
+/// @return tf::tree_closest_point_pair<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1, aabb_metrics_f, closest_points_f, result, paralelism_depth,
+      budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      result, paralelism_depth, budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, result,
+      paralelism_depth, budget);
+  return result.points;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_closest_point_pair<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, result,
+      paralelism_depth, budget);
+  return result.points;
+}
+
+/// @brief Perform a budgeted k-nearest-pairs query between two tree structures, in parallel.
+///
+/// Tasks share `budget`, and stop when it is exhausted, returning the best
+/// result found so far. Use `budget.partial()` to check whether that happened.
+///
+/// @param tree0 The first spatial tree to query.
+/// @param tree1 The second spatial tree to query.
+/// @param aabb_metrics_f A function that estimates the distances between two AABBs.
+///                       Signature: `(const tf::aabb<RealT, N>& a, const tf::aabb<RealT, N>& b) -> tf::aabb_metrics<RealT>`
+/// @param closest_points_f A function that evaluates the true distance between a pair of primitives.
+///                         Signature: `(Index id0, Index id1) -> tf::closest_point_pair<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+/// @param paralelism_depth The number of tree levels split into parallel tasks.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1, aabb_metrics_f, closest_points_f, knn, paralelism_depth,
+      budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.main_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1.delta_tree(), aabb_metrics_f, closest_points_f,
+      knn, paralelism_depth, budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::tree<Index, RealT, N> &tree0,
+                     const tf::mod_tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.main_tree(), aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0, tree1.delta_tree(), aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth, budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::parallel_t,
+                     const tf::mod_tree<Index, RealT, N> &tree0,
+                     const tf::tree<Index, RealT, N> &tree1,
+                     const F0 &aabb_metrics_f, const F1 &closest_points_f,
+                     tree_knn<RandomIt> &knn, const tf::query_budget &budget,
+                     int paralelism_depth = 3) {
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.main_tree(), tree1, aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth, budget);
+  tf::implementation::tree_tree_proximity_parallel(
+      tree0.delta_tree(), tree1, aabb_metrics_f, closest_points_f, knn,
+      paralelism_depth, budget);
+  knn.finalize();
+}
+
+// warm-started
+
+/// @brief Perform a warm-started nearest-point query against a single tree structure.
+///
+/// The hinted primitive (typically the result of the previous query for a
+/// moving target) is evaluated first, so that the traversal starts with a
+/// tight bound. The result is the same as without the hint.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param hint The primitive to evaluate first, see @ref tf::nearness_hint.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::nearness_hint<Index> &hint) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric,
+      tf::implementation::hinted_leaf_f(hint, closest_point_f), result);
+  return result.point;
+}
+
+/// @brief Perform a warm-started nearest-point query against a single tree structure.
+///
+/// The hinted primitive (typically the result of the previous query for a
+/// moving target) is evaluated first, so that the traversal starts with a
+/// tight bound. The result is the same as without the hint.
+/// The hint must be a primitive that is still in the tree.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param hint The primitive to evaluate first, see @ref tf::nearness_hint.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::nearness_hint<Index> &hint) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  auto leaf_f = tf::implementation::hinted_leaf_f(hint, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric, leaf_f,
+      result);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric, leaf_f,
+      result);
+  return result.point;
+}
+
+/// @brief Perform a warm-started nearest-point query against a single tree structure.
+///
+/// The hinted primitive (typically the result of the previous query for a
+/// moving target) is evaluated first, so that the traversal starts with a
+/// tight bound. The result is the same as without the hint.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius for the query
+/// @param hint The primitive to evaluate first, see @ref tf::nearness_hint.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     RealT radius, const tf::nearness_hint<Index> &hint) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{radius *
+                                                                 radius};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric,
+      tf::implementation::hinted_leaf_f(hint, closest_point_f), result);
+  return result.point;
+}
+
+/// @brief Perform a warm-started nearest-point query against a single tree structure.
+///
+/// The hinted primitive (typically the result of the previous query for a
+/// moving target) is evaluated first, so that the traversal starts with a
+/// tight bound. The result is the same as without the hint.
+/// The hint must be a primitive that is still in the tree.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius for the query
+/// @param hint The primitive to evaluate first, see @ref tf::nearness_hint.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     RealT radius, const tf::nearness_hint<Index> &hint) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{radius *
+                                                                 radius};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  auto leaf_f = tf::implementation::hinted_leaf_f(hint, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric, leaf_f,
+      result);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric, leaf_f,
+      result);
+  return result.point;
+}
+
+/// @brief Perform a budgeted, warm-started nearest-point query against a single tree structure.
+///
+/// The hinted primitive is evaluated first, see @ref tf::nearness_hint. The
+/// traversal stops when `budget` is exhausted, returning the best result
+/// found so far, which is never farther than the hinted primitive.
+/// Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param hint The primitive to evaluate first, see @ref tf::nearness_hint.
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::nearness_hint<Index> &hint,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric,
+      tf::implementation::hinted_leaf_f(hint, closest_point_f), result,
+      Index(0), budget);
+  return result.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::nearness_hint<Index> &hint,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::warm_start(hint, result, closest_point_f);
+  auto leaf_f = tf::implementation::hinted_leaf_f(hint, closest_point_f);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric, leaf_f,
+      result, Index(0), budget);
+  tf::implementation::tree_closest_point_leaves_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric, leaf_f,
+      result, Index(0), budget);
+  return result.point;
+}
+
+// approximate
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::top_k_sorted_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result);
+  return closest.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::top_k_sorted_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  return closest.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::priority_queue_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_heap(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result);
+  return closest.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(strategy::priority_queue_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_heap(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  tf::implementation::tree_closest_point_using_heap(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  return closest.point;
+}
+
+/// @brief Perform an approximate nearest-point query against a single tree structure.
+///
+/// Nodes are pruned when their AABB metric exceeds the current bound divided
+/// by `(1 + epsilon)^2`, see @ref tf::approximation. The tree is searched
+/// using a top-k sorted traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  return nearness_search(strategy::top_k_sorted, tree, aabb_metric,
+                         closest_point_f, approximation);
+}
+
+/// @brief Perform an approximate nearest-point query against a single tree structure.
+///
+/// Nodes are pruned when their AABB metric exceeds the current bound divided
+/// by `(1 + epsilon)^2`, see @ref tf::approximation. The tree is searched
+/// using a top-k sorted traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation) {
+  return nearness_search(strategy::top_k_sorted, tree, aabb_metric,
+                         closest_point_f, approximation);
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::top_k_sorted_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::top_k_sorted_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::priority_queue_t,
+                     const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_heap(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(strategy::priority_queue_t,
+                     const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_heap(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  tf::implementation::tree_closest_point_using_heap(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result);
+  knn.finalize();
+}
+
+/// @brief Perform an approximate knn query against a single tree structure.
+///
+/// Nodes are pruned when their AABB metric exceeds the current bound divided
+/// by `(1 + epsilon)^2`, see @ref tf::approximation. The tree is searched
+/// using a top-k sorted traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  return nearness_search(strategy::top_k_sorted, tree, aabb_metric,
+                         closest_point_f, knn, approximation);
+}
+
+/// @brief Perform an approximate knn query against a single tree structure.
+///
+/// Nodes are pruned when their AABB metric exceeds the current bound divided
+/// by `(1 + epsilon)^2`, see @ref tf::approximation. The tree is searched
+/// using a top-k sorted traversal strategy.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation) {
+  return nearness_search(strategy::top_k_sorted, tree, aabb_metric,
+                         closest_point_f, knn, approximation);
+}
+
+// transformed_tree
+
+/// @brief Find the closest primitive of an instanced tree to a query point.
+///
+/// The world-space point is transformed into the local frame of the tree
+/// once. The closest point is reported in the world frame.
+///
+/// @param tree The transformed tree view.
+/// @param point The query point, in the world frame.
+/// @param closest_point_f A function that evaluates the true distance to a
+/// primitive, in the local frame.
+///                        Signature: `(Index id, const tf::vector<RealT, N>&
+///                        local_point) -> tf::closest_point<RealT, N>`
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto nearness_search(const tf::transformed_tree<Index, RealT, N> &tree,
+                     const tf::vector<RealT, N> &point,
+                     const F &closest_point_f) {
+  auto local_point = tree.inverse_transformation().transform_point(point);
+  auto result = nearness_search(
+      tree.tree(),
+      [&local_point](const tf::aabb<RealT, N> &aabb) {
+        return tf::distance2(aabb, local_point);
+      },
+      [&](Index id) { return closest_point_f(id, local_point); });
+  if (result)
+    result.point.point =
+        tree.transformation().transform_point(result.point.point);
+  return result;
+}
+
+/// @brief Find the k closest primitives of an instanced tree to a query point.
+///
+/// The world-space point is transformed into the local frame of the tree
+/// once. Closest points are reported in the world frame.
+///
+/// @param tree The transformed tree view.
+/// @param point The query point, in the world frame.
+/// @param closest_point_f A function that evaluates the true distance to a
+/// primitive, in the local frame.
+///                        Signature: `(Index id, const tf::vector<RealT, N>&
+///                        local_point) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+template <typename Index, typename RealT, std::size_t N, typename F,
+          typename RandomIt>
+auto nearness_search(const tf::transformed_tree<Index, RealT, N> &tree,
+                     const tf::vector<RealT, N> &point,
+                     const F &closest_point_f, tf::tree_knn<RandomIt> &knn) {
+  auto local_point = tree.inverse_transformation().transform_point(point);
+  nearness_search(
+      tree.tree(),
+      [&local_point](const tf::aabb<RealT, N> &aabb) {
+        return tf::distance2(aabb, local_point);
+      },
+      [&](Index id) {
+        auto closest = closest_point_f(id, local_point);
+        closest.point = tree.transformation().transform_point(closest.point);
+        return closest;
+      },
+      knn);
+}
+
+/// @brief Perform a budgeted, approximate nearest-point query against a single tree structure.
+///
+/// Nodes are pruned as described in @ref tf::approximation. The traversal
+/// stops when `budget` is exhausted, returning the best result found so far.
+/// Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result, Index(0),
+      budget);
+  return closest.point;
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     const tf::approximation<RealT> &approximation,
+                     const tf::query_budget &budget) {
+  tf::implementation::tree_closest_point<Index, RealT, N> closest{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::approximate_result<decltype(closest), RealT> result{
+      closest, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  return closest.point;
+}
+
+/// @brief Perform a budgeted, approximate knn query against a single tree structure.
+///
+/// Nodes are pruned as described in @ref tf::approximation. The traversal
+/// stops when `budget` is exhausted, returning the best result found so far.
+/// Use `budget.partial()` to check whether that happened.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param knn The accumulator `tf::tree_knn` for the query
+/// @param approximation The approximation parameters, see `tf::make_approximation`.
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation,
+                     const tf::query_budget &budget) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, result, Index(0),
+      budget);
+  knn.finalize();
+}
+
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename RandomIt>
+auto nearness_search(const tf::mod_tree<Index, RealT, N> &tree,
+                     const F0 &aabb_metric, const F1 &closest_point_f,
+                     tf::tree_knn<RandomIt> &knn,
+                     const tf::approximation<RealT> &approximation,
+                     const tf::query_budget &budget) {
+  tf::implementation::approximate_result<tf::tree_knn<RandomIt>, RealT> result{
+      knn, approximation};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      closest_point_f, result, Index(0), budget);
+  knn.finalize();
 }
 
 } // namespace tf
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./closest_point.hpp"
+#include "./implementation/tree_closest_point.hpp"
+#include "./implementation/tree_closest_point_using_sort_by_level.hpp"
+#include "./mod_tree.hpp"
+#include "./range.hpp"
+#include "./small_buffer.hpp"
+#include "./tree.hpp"
+#include <limits>
+
+namespace tf::implementation {
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search_broad(const tf::tree<Index, RealT, N> &tree,
+                           const F0 &aabb_metric, const F1 &leaf_closest_f,
+                           tree_closest_point<Index, RealT, N> &result)
+    -> void {
+  tf::small_buffer<tf::closest_point<RealT, N>, 64> points;
+  tree_closest_point_leaves_using_sort_by_level(
+      tree.nodes(), tree.ids(), aabb_metric,
+      [&](const auto &ids, auto &result) {
+        points.resize(ids.size());
+        leaf_closest_f(ids, tf::make_range(points.begin(), points.size()));
+        for (std::size_t i = 0; i < std::size_t(ids.size()); ++i)
+          result.update(ids[i], points[i]);
+      },
+      result);
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Perform a nearest-point query against a single tree, evaluating
+/// the primitives of a leaf in one call.
+///
+/// The leaf-batched counterpart of @ref tf::nearness_search, as
+/// @ref tf::search_broad is for @ref tf::search. Instead of one call per
+/// primitive, `leaf_closest_f` receives the ids of a whole leaf and fills
+/// in their closest points, so that a primitive kernel can be vectorized
+/// across the leaf.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param leaf_closest_f A function that evaluates the closest points of the
+/// primitives of a leaf.
+///                       Signature: `(const Range& ids, Points points) ->
+///                       void`, where `points` is a range of
+///                       `tf::closest_point<RealT, N>` of the same size as
+///                       `ids`, to be filled in.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search_broad(const tf::tree<Index, RealT, N> &tree,
+                           const F0 &aabb_metric, const F1 &leaf_closest_f)
+    -> tf::tree_closest_point<Index, RealT, N> {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::nearness_search_broad(tree, aabb_metric, leaf_closest_f,
+                                            result);
+  return result.point;
+}
+
+/// @brief Perform a nearest-point query against a single tree, evaluating
+/// the primitives of a leaf in one call.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param leaf_closest_f A function that evaluates the closest points of the
+/// primitives of a leaf.
+///                       Signature: `(const Range& ids, Points points) ->
+///                       void`, where `points` is a range of
+///                       `tf::closest_point<RealT, N>` of the same size as
+///                       `ids`, to be filled in.
+///
+/// @return tf::tree_closest_point<Index, RealT, N>.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto nearness_search_broad(const tf::mod_tree<Index, RealT, N> &tree,
+                           const F0 &aabb_metric, const F1 &leaf_closest_f)
+    -> tf::tree_closest_point<Index, RealT, N> {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::nearness_search_broad(tree.main_tree(), aabb_metric,
+                                            leaf_closest_f, result);
+  tf::implementation::nearness_search_broad(tree.delta_tree(), aabb_metric,
+                                            leaf_closest_f, result);
+  return result.point;
+}
+
+} // namespace tf
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/expansion.hpp"
+#include <cmath>
+
+namespace tf::implementation {
+template <typename Point0, typename Point1, typename Point2>
+auto orient2d_exact(const Point0 &a, const Point1 &b, const Point2 &c)
+    -> int {
+  auto acx = make_expansion_difference(double(a[0]), double(c[0]));
+  auto acy = make_expansion_difference(double(a[1]), double(c[1]));
+  auto bcx = make_expansion_difference(double(b[0]), double(c[0]));
+  auto bcy = make_expansion_difference(double(b[1]), double(c[1]));
+  return expansion_sign(exact_cross(acx, acy, bcx, bcy));
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief The exact orientation of three points in 2D.
+///
+/// Returns the sign of `(a - c) × (b - c)`: positive if `a`, `b` and `c`
+/// are in counterclockwise order, negative if clockwise, and zero if they
+/// are collinear. Only the first two coordinates of the points are read.
+///
+/// The determinant is evaluated in double precision, together with an
+/// error bound. Only when the bound does not certify the sign is it
+/// recomputed exactly with floating-point expansions. The result is exact
+/// for `float` and `double` coordinates.
+///
+/// @return `-1`, `0` or `1`.
+template <typename Point0, typename Point1, typename Point2>
+auto orient2d(const Point0 &a, const Point1 &b, const Point2 &c) -> int {
+  double detleft = (double(a[0]) - double(c[0])) * (double(b[1]) - double(c[1]));
+  double detright =
+      (double(a[1]) - double(c[1])) * (double(b[0]) - double(c[0]));
+  double det = detleft - detright;
+  // Shewchuk's bound for the determinant evaluated above
+  constexpr double epsilon = 1.1102230246251565e-16; // 2^-53
+  constexpr double error_bound = (3.0 + 16.0 * epsilon) * epsilon;
+  double error = error_bound * (std::abs(detleft) + std::abs(detright));
+  if (det > error)
+    return 1;
+  if (-det > error)
+    return -1;
+  return implementation::orient2d_exact(a, b, c);
+}
+
+} // namespace tf
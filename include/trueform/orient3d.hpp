@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/expansion.hpp"
+#include <cmath>
+
+namespace tf::implementation {
+template <typename Point0, typename Point1, typename Point2, typename Point3>
+auto orient3d_exact(const Point0 &a, const Point1 &b, const Point2 &c,
+                    const Point3 &d) -> int {
+  auto adx = make_expansion_difference(double(a[0]), double(d[0]));
+  auto ady = make_expansion_difference(double(a[1]), double(d[1]));
+  auto adz = make_expansion_difference(double(a[2]), double(d[2]));
+  auto bdx = make_expansion_difference(double(b[0]), double(d[0]));
+  auto bdy = make_expansion_difference(double(b[1]), double(d[1]));
+  auto bdz = make_expansion_difference(double(b[2]), double(d[2]));
+  auto cdx = make_expansion_difference(double(c[0]), double(d[0]));
+  auto cdy = make_expansion_difference(double(c[1]), double(d[1]));
+  auto cdz = make_expansion_difference(double(c[2]), double(d[2]));
+  auto det = expansion_sum(
+      expansion_sum(expansion_product(adx, exact_cross(bdy, bdz, cdy, cdz)),
+                    expansion_product(bdx, exact_cross(cdy, cdz, ady, adz))),
+      expansion_product(cdx, exact_cross(ady, adz, bdy, bdz)));
+  return expansion_sign(det);
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief The exact orientation of four points in 3D.
+///
+/// Returns the sign of `(a - d) · ((b - d) × (c - d))`: positive if `d`
+/// lies below the plane through `a`, `b` and `c` (where they appear
+/// counterclockwise from above), negative if above, and zero if the four
+/// points are coplanar.
+///
+/// The determinant is evaluated in double precision, together with an
+/// error bound. Only when the bound does not certify the sign is it
+/// recomputed exactly with floating-point expansions. The result is exact
+/// for `float` and `double` coordinates.
+///
+/// @return `-1`, `0` or `1`.
+template <typename Point0, typename Point1, typename Point2, typename Point3>
+auto orient3d(const Point0 &a, const Point1 &b, const Point2 &c,
+              const Point3 &d) -> int {
+  double adx = double(a[0]) - double(d[0]);
+  double ady = double(a[1]) - double(d[1]);
+  double adz = double(a[2]) - double(d[2]);
+  double bdx = double(b[0]) - double(d[0]);
+  double bdy = double(b[1]) - double(d[1]);
+  double bdz = double(b[2]) - double(d[2]);
+  double cdx = double(c[0]) - double(d[0]);
+  double cdy = double(c[1]) - double(d[1]);
+  double cdz = double(c[2]) - double(d[2]);
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+  double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) +
+               cdz * (adxbdy - bdxady);
+  double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                     (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                     (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+  // Shewchuk's bound for the determinant evaluated above
+  constexpr double epsilon = 1.1102230246251565e-16; // 2^-53
+  constexpr double error_bound = (7.0 + 56.0 * epsilon) * epsilon;
+  double error = error_bound * permanent;
+  if (det > error)
+    return 1;
+  if (-det > error)
+    return -1;
+  return implementation::orient3d_exact(a, b, c, d);
+}
+
+} // namespace tf
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./implementation/tree_dual_search.hpp"
+#include "./implementation/tree_front_search.hpp"
+#include "./implementation/tree_self_search.hpp"
+#include "./transformation.hpp"
+#include "./tree.hpp"
+
+namespace tf {
+
+/// @brief A persistent cache of node pairs for frame-coherent searches.
+///
+/// A search between two trees (or a tree and itself) stops at a front of
+/// node pairs: pairs of nodes that were found separated, and pairs of
+/// overlapping leaves. `tf::pair_cache` keeps this front between calls
+/// to @ref tf::search and @ref tf::search_self, together with a copy of the
+/// nodes of the trees.
+///
+/// The next search compares every node to that copy, to find the nodes whose
+/// boxes changed, e.g. by @ref tf::tree::refit. It then starts from the
+/// cached front instead of the roots:
+/// - pairs of unchanged nodes are kept without testing their boxes, and
+///   cached pairs of overlapping leaves below them are reapplied,
+/// - pairs of changed nodes that started to overlap are descended,
+/// - pairs that stay separated are periodically moved up to the highest
+///   separated pair.
+///
+/// Finding the changed nodes is a linear pass over the nodes of both trees,
+/// of the same order as a refit. When only parts of the trees move between
+/// calls, the number of boxes tested then scales with the change, rather
+/// than with the size of the trees. Primitive pairs of overlapping leaves
+/// are still reported on every call. Only `tf::tree` is supported.
+///
+/// The cache is reset when it is used with different trees, or when the
+/// number of nodes of a tree changes. Call `clear()` after rebuilding a tree
+/// in place. `check_aabbs` must be monotone: if a pair of nodes passes, so
+/// must the pair of their parents. It must also give the same result for the
+/// same pair of boxes in every call. A search between transformed trees
+/// retests all cached pairs when the relative transformation changes.
+///
+/// @tparam Index The type used for node and primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+/// @tparam N The spatial dimension.
+template <typename Index, typename RealT, std::size_t N> class pair_cache {
+public:
+  /// @brief The number of cached node pairs.
+  auto size() const -> std::size_t { return _front.size(); }
+
+  /// @brief Clear the cache. The next search starts at the roots.
+  auto clear() -> void {
+    _front.clear();
+    _ancestry0.clear();
+    _ancestry1.clear();
+    _changes0.clear();
+    _changes1.clear();
+    _tree0 = nullptr;
+    _tree1 = nullptr;
+    _has_transformation = false;
+    _n_searches = 0;
+    _compacted_size = 0;
+  }
+
+  /// @brief Store the relative transformation of the next search.
+  ///
+  /// Used by @ref tf::search on transformed trees, whose box test depends on
+  /// the transformation.
+  ///
+  /// @return `true` if it differs from the one stored before. The first
+  /// transformation is not a change, as there are no cached pairs yet.
+  auto update_transformation(const tf::transformation<RealT, N> &relative)
+      -> bool {
+    bool changed = false;
+    for (std::size_t i = 0; i < N && _has_transformation; ++i)
+      for (std::size_t j = 0; j <= N; ++j)
+        changed = changed || _transformation(i, j) != relative(i, j);
+    _transformation = relative;
+    _has_transformation = true;
+    return changed;
+  }
+
+  /// @brief Run a search from the cached front, and store the new front.
+  ///
+  /// Used by @ref tf::search and @ref tf::search_self, which expand leaf
+  /// pairs into primitive pairs.
+  ///
+  /// @param leaves_apply Called for every pair of overlapping leaves.
+  ///                     Signature: `(ids0, ids1, bool is_self) -> bool`
+  /// @param check_changed Set if `check_aabbs` changed since the last
+  /// search. Every cached pair would have to be retested, so the search
+  /// runs from the roots, and the front is rebuilt by the next search.
+  /// @return `true` if `leaves_apply` aborted the search.
+  template <typename F0, typename F1, typename F2>
+  auto search(const tf::tree<Index, RealT, N> &tree0,
+              const tf::tree<Index, RealT, N> &tree1, bool is_self,
+              const F0 &check_aabbs, const F1 &leaves_apply, const F2 &abort,
+              int paralelism_depth, bool check_changed = false) -> bool {
+    if (_tree0 != &tree0 || _tree1 != &tree1 || _is_self != is_self ||
+        _changes0.snapshot.size() != tree0.nodes().size() ||
+        (!is_self && _changes1.snapshot.size() != tree1.nodes().size())) {
+      auto has_transformation = _has_transformation;
+      clear();
+      _has_transformation = has_transformation;
+      _tree0 = &tree0;
+      _tree1 = &tree1;
+      _is_self = is_self;
+      _ancestry0.build(tree0.nodes());
+      if (!is_self)
+        _ancestry1.build(tree1.nodes());
+    }
+    _changes0.update(tree0.nodes());
+    if (!is_self)
+      _changes1.update(tree1.nodes());
+    if (check_changed) {
+      _front.clear();
+      _compacted_size = 0;
+      if (is_self)
+        return tf::implementation::tree_self_search(
+            tree0.nodes(), tree0.ids(), check_aabbs, leaves_apply, abort,
+            paralelism_depth);
+      return tf::implementation::tree_dual_search(
+          tree0.nodes(), tree0.ids(), tree1.nodes(), tree1.ids(), check_aabbs,
+          [&leaves_apply](const auto &r0, const auto &r1) {
+            return leaves_apply(r0, r1, false);
+          },
+          abort, paralelism_depth);
+    }
+    // the front only grows between compactions
+    bool compact = ++_n_searches % compaction_period == 0 ||
+                   _front.size() > 2 * _compacted_size;
+    auto found = tf::implementation::tree_front_search(
+        _front, tree0.nodes(), tree0.ids(), _ancestry0, _changes0,
+        tree1.nodes(), tree1.ids(), is_self ? _ancestry0 : _ancestry1,
+        is_self ? _changes0 : _changes1, is_self, check_aabbs, leaves_apply,
+        abort, compact, paralelism_depth);
+    if (compact)
+      _compacted_size = _front.size();
+    return found;
+  }
+
+private:
+  static constexpr std::size_t compaction_period = 16;
+  tf::buffer<tf::implementation::front_pair<Index>> _front;
+  tf::implementation::tree_ancestry<Index> _ancestry0;
+  tf::implementation::tree_ancestry<Index> _ancestry1;
+  tf::implementation::tree_changes<Index, RealT, N> _changes0;
+  tf::implementation::tree_changes<Index, RealT, N> _changes1;
+  tf::transformation<RealT, N> _transformation;
+  bool _has_transformation = false;
+  const void *_tree0 = nullptr;
+  const void *_tree1 = nullptr;
+  bool _is_self = false;
+  std::size_t _n_searches = 0;
+  std::size_t _compacted_size = 0;
+};
+
+} // namespace tf
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./buffer.hpp"
+#include "./closest_point.hpp"
+#include "./closest_point_on_triangle.hpp"
+#include "./distance.hpp"
+#include "./dot.hpp"
+#include "./implementation/morton_code.hpp"
+#include "./implementation/tree_closest_point.hpp"
+#include "./implementation/tree_closest_point_using_sort_by_level.hpp"
+#include "./indirect_range.hpp"
+#include "./mod_tree.hpp"
+#include "./nearness_hint.hpp"
+#include "./tree.hpp"
+#include "./vector.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace tf {
+
+/// @brief The projections of points onto a triangle mesh.
+///
+/// Stored as a structure of arrays: for query `i`, `elements[i]` is the
+/// closest triangle, `points[i]` the closest point on it, and
+/// `barycentrics[i]` the barycentric coordinates of that point with respect
+/// to the vertices of the triangle.
+///
+/// Returned by @ref tf::project_points.
+///
+/// @tparam Index The type used for primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+template <typename Index, typename RealT> struct point_projections {
+  tf::buffer<Index> elements;
+  tf::buffer<tf::vector<RealT, 3>> points;
+  tf::buffer<tf::vector<RealT, 3>> barycentrics;
+
+  /// @brief The number of projected points.
+  auto size() const -> std::size_t { return elements.size(); }
+};
+
+} // namespace tf
+
+namespace tf::implementation {
+
+// The barycentric coordinates of a point in the plane of a triangle.
+// Degenerate triangles map every point to their first vertex.
+template <typename RealT, typename Range>
+auto barycentric_coordinates(const Range &triangle,
+                             const tf::vector<RealT, 3> &point)
+    -> tf::vector<RealT, 3> {
+  auto ab = triangle[1] - triangle[0];
+  auto ac = triangle[2] - triangle[0];
+  auto ap = point - triangle[0];
+  auto d00 = tf::dot(ab, ab);
+  auto d01 = tf::dot(ab, ac);
+  auto d11 = tf::dot(ac, ac);
+  auto d20 = tf::dot(ap, ab);
+  auto d21 = tf::dot(ap, ac);
+  auto denom = d00 * d11 - d01 * d01;
+  if (denom == 0)
+    return tf::make_vector<RealT, 3>({1, 0, 0});
+  RealT v = (d11 * d20 - d01 * d21) / denom;
+  RealT w = (d00 * d21 - d01 * d20) / denom;
+  return tf::make_vector<RealT, 3>({1 - v - w, v, w});
+}
+
+template <typename Index, typename RealT, typename F0, typename F1,
+          typename Result>
+auto closest_point_using_stack(const tf::tree<Index, RealT, 3> &tree,
+                               const F0 &aabb_metric_f, const F1 &leaf_f,
+                               Result &result,
+                               tree_closest_point_stack<Index, RealT> &stack)
+    -> void {
+  tree_closest_point_leaves_using_stack(tree.nodes(), tree.ids(),
+                                        aabb_metric_f, leaf_f, result, stack);
+}
+
+template <typename Index, typename RealT, typename F0, typename F1,
+          typename Result>
+auto closest_point_using_stack(const tf::mod_tree<Index, RealT, 3> &tree,
+                               const F0 &aabb_metric_f, const F1 &leaf_f,
+                               Result &result,
+                               tree_closest_point_stack<Index, RealT> &stack)
+    -> void {
+  closest_point_using_stack(tree.main_tree(), aabb_metric_f, leaf_f, result,
+                            stack);
+  closest_point_using_stack(tree.delta_tree(), aabb_metric_f, leaf_f, result,
+                            stack);
+}
+
+// The queries, ordered along a Morton curve over their bounding box.
+template <typename RealT, typename Range>
+auto morton_order(const Range &queries) -> tf::buffer<std::size_t> {
+  tf::aabb<RealT, 3> aabb;
+  for (int d = 0; d < 3; ++d) {
+    aabb.min[d] = std::numeric_limits<RealT>::max();
+    aabb.max[d] = std::numeric_limits<RealT>::lowest();
+  }
+  for (const auto &query : queries)
+    for (int d = 0; d < 3; ++d) {
+      aabb.min[d] = std::min(aabb.min[d], RealT(query[d]));
+      aabb.max[d] = std::max(aabb.max[d], RealT(query[d]));
+    }
+  tf::buffer<std::uint32_t> codes;
+  codes.allocate(queries.size());
+  tf::buffer<std::size_t> order;
+  order.allocate(queries.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, queries.size()),
+                    [&](const tbb::blocked_range<std::size_t> &range) {
+                      for (auto i = range.begin(); i < range.end(); ++i) {
+                        codes[i] = morton_code(aabb, queries[i]);
+                        order[i] = i;
+                      }
+                    });
+  tbb::parallel_sort(order.begin(), order.end(),
+                     [&codes](std::size_t i, std::size_t j) {
+                       return codes[i] < codes[j];
+                     });
+  return order;
+}
+
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1, typename Range2>
+auto project_points(const Tree &tree, const Range0 &triangles,
+                    const Range1 &points, const Range2 &queries)
+    -> tf::point_projections<Index, RealT> {
+  tf::point_projections<Index, RealT> out;
+  out.elements.allocate(queries.size());
+  out.points.allocate(queries.size());
+  out.barycentrics.allocate(queries.size());
+  auto order = morton_order<RealT>(queries);
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, queries.size(), 64),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        tree_closest_point_stack<Index, RealT> stack;
+        tf::nearness_hint<Index> hint;
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          auto id = order[i];
+          auto q = tf::make_vector<RealT, 3>(
+              {RealT(queries[id][0]), RealT(queries[id][1]),
+               RealT(queries[id][2])});
+          auto closest_point_f = [&](Index face) {
+            auto cpt = tf::closest_point_on_triangle(
+                tf::make_indirect_range(triangles[face], points), q);
+            return tf::make_closest_point((cpt - q).length2(), cpt);
+          };
+          tree_closest_point<Index, RealT, 3> result{
+              std::numeric_limits<RealT>::max()};
+          // neighbouring queries in Morton order tend to share the closest
+          // triangle, which then bounds the traversal from the start
+          warm_start(hint, result, closest_point_f);
+          closest_point_using_stack(
+              tree,
+              [&q](const tf::aabb<RealT, 3> &aabb) {
+                return tf::distance2(aabb, q);
+              },
+              hinted_leaf_f(hint, closest_point_f), result, stack);
+          const auto &closest = result.point;
+          if (!closest) {
+            out.elements[id] = -1;
+            continue;
+          }
+          hint = tf::make_nearness_hint(closest.element);
+          out.elements[id] = closest.element;
+          out.points[id] = closest.point.point;
+          out.barycentrics[id] = barycentric_coordinates<RealT>(
+              tf::make_indirect_range(triangles[closest.element], points),
+              closest.point.point);
+        }
+      });
+  return out;
+}
+
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Project many points onto a triangle mesh in parallel.
+///
+/// For every query, finds the closest triangle, the closest point on it and
+/// its barycentric coordinates. The queries are processed in Morton order,
+/// so that each is warm-started with the closest triangle of its neighbour
+/// along the curve, and every task reuses one traversal stack for all of
+/// its queries. Results are written in the original order of the queries.
+///
+/// Use @ref tf::interpolate_attributes to transfer per-vertex attributes
+/// of the mesh to the projected points.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param queries A range of query points.
+///
+/// @return tf::point_projections<Index, RealT>. An empty tree gives
+/// elements of -1.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2>
+auto project_points(const tf::tree<Index, RealT, 3> &tree,
+                    const Range0 &triangles, const Range1 &points,
+                    const Range2 &queries)
+    -> tf::point_projections<Index, RealT> {
+  return tf::implementation::project_points<Index, RealT>(tree, triangles,
+                                                          points, queries);
+}
+
+/// @brief Project many points onto a triangle mesh in parallel.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::point_projections<Index, RealT>.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2>
+auto project_points(const tf::mod_tree<Index, RealT, 3> &tree,
+                    const Range0 &triangles, const Range1 &points,
+                    const Range2 &queries)
+    -> tf::point_projections<Index, RealT> {
+  return tf::implementation::project_points<Index, RealT>(tree, triangles,
+                                                          points, queries);
+}
+
+/// @brief Interpolate per-vertex attributes at projected points.
+///
+/// For projection `i`, the attributes of the vertices of its triangle are
+/// gathered with `tf::make_indirect_range` and blended with its barycentric
+/// coordinates. Any attribute that can be scaled by `RealT` and summed
+/// works, e.g. scalars, colors or displacement vectors.
+///
+/// @param projections The result of @ref tf::project_points.
+/// @param triangles The triangles that were projected onto.
+/// @param attributes A range of attributes, one per point of the mesh.
+///
+/// @return tf::buffer of the interpolated attributes, one per projection.
+/// Projections without a triangle get a value-initialized attribute.
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto interpolate_attributes(
+    const tf::point_projections<Index, RealT> &projections,
+    const Range0 &triangles, const Range1 &attributes) {
+  using value_t = std::decay_t<decltype(attributes[0] * RealT(1))>;
+  tf::buffer<value_t> out;
+  out.allocate(projections.size());
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, projections.size()),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          auto element = projections.elements[i];
+          if (element == Index(-1)) {
+            out[i] = value_t{};
+            continue;
+          }
+          auto values = tf::make_indirect_range(triangles[element], attributes);
+          const auto &b = projections.barycentrics[i];
+          out[i] = values[0] * b[0] + values[1] * b[1] + values[2] * b[2];
+        }
+      });
+  return out;
+}
+
+} // namespace tf
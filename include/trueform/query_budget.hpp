@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_arena.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace tf {
+
+/// @brief A node-visit and time budget for spatial queries.
+///
+/// `tf::query_budget` is a callable `() -> bool` that returns `true` once the
+/// budget is exhausted. It may be passed wherever a query takes an `abort`
+/// functor (e.g. @ref tf::search between two trees, @ref tf::search_self),
+/// and to the budgeted overloads of single-tree searches, @ref tf::nearness_search
+/// and @ref tf::radius_search. The nearness overloads cover the single-tree,
+/// knn and tree-tree queries on any mix of `tf::tree` and `tf::mod_tree`,
+/// their parallel variants, and the approximate and warm-started queries.
+///
+/// Each call counts one node visit. Visits are counted per thread, and
+/// flushed into the shared count every 256 visits, when the clock is read
+/// as well. Each thread caches its counter of the budget it last checked,
+/// so the thread-specific storage is only looked up when a thread switches
+/// budgets. Checking the budget is thus cheap, and threads of a parallel
+/// query do not contend for the counter. For small node limits, visits are
+/// flushed more often, so that the limit is exceeded by at most a quarter.
+/// Once exhausted, the budget stays exhausted and the query returns the best
+/// result found so far. Use `partial()` to test whether that happened.
+///
+/// A budget is safe to share between threads. Use `tf::make_query_budget`
+/// to create an instance; the time limit starts counting at construction.
+class query_budget {
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  query_budget(std::size_t node_limit, clock_t::time_point deadline)
+      : node_limit{node_limit}, deadline{deadline},
+        flush_size{std::clamp<std::size_t>(
+            node_limit /
+                (4 * std::size_t(tbb::this_task_arena::max_concurrency())),
+            1, max_flush_size)},
+        id{next_id()} {}
+
+  query_budget(const query_budget &) = delete;
+  auto operator=(const query_budget &) -> query_budget & = delete;
+
+  /// @brief Count a node visit and check the budget.
+  ///
+  /// @return `true` if the budget is exhausted and the query should stop.
+  auto operator()() const -> bool {
+    if (exhausted.load(std::memory_order_relaxed))
+      return true;
+    auto &local = thread_count();
+    // only the owning thread writes its count, so there is no contention
+    auto count = local.load(std::memory_order_relaxed) + 1;
+    if (count < flush_size) {
+      local.store(count, std::memory_order_relaxed);
+      return false;
+    }
+    local.store(0, std::memory_order_relaxed);
+    auto total = visits.fetch_add(count, std::memory_order_relaxed) + count;
+    if (total > node_limit || clock_t::now() >= deadline) {
+      exhausted.store(true, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  /// @brief Check whether a query was interrupted by this budget.
+  ///
+  /// @return `true` if the budget was exhausted, and results are partial.
+  auto partial() const -> bool {
+    return exhausted.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Return the number of node visits counted so far.
+  ///
+  /// Includes the visits not yet flushed by each thread. Call it once the
+  /// queries using the budget have returned.
+  auto visited() const -> std::size_t {
+    auto count = visits.load(std::memory_order_relaxed);
+    for (const auto &local : local_visits)
+      count += local.count.load(std::memory_order_relaxed);
+    return count;
+  }
+
+private:
+  struct local_count {
+    std::atomic<std::size_t> count{0};
+  };
+
+  // the counter of this thread, cached for the budget it last checked.
+  // Ids are never reused, so a stale cache of a destroyed budget can
+  // not be mistaken for a new budget at the same address.
+  auto thread_count() const -> std::atomic<std::size_t> & {
+    struct cache_t {
+      std::uint64_t id;
+      std::atomic<std::size_t> *count;
+    };
+    static thread_local cache_t cache{0, nullptr};
+    if (cache.id != id)
+      cache = {id, &local_visits.local().count};
+    return *cache.count;
+  }
+
+  static auto next_id() -> std::uint64_t {
+    static std::atomic<std::uint64_t> ids{0};
+    return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  static constexpr std::size_t max_flush_size = 256;
+  std::size_t node_limit;
+  clock_t::time_point deadline;
+  std::size_t flush_size;
+  std::uint64_t id;
+  mutable tbb::enumerable_thread_specific<local_count> local_visits;
+  mutable std::atomic<std::size_t> visits{0};
+  mutable std::atomic<bool> exhausted{false};
+};
+
+/// @brief Create a budget that limits the number of node visits.
+///
+/// @param node_limit The maximal number of node visits.
+/// @return A `tf::query_budget` instance.
+inline auto make_query_budget(std::size_t node_limit) -> query_budget {
+  return query_budget{node_limit, query_budget::clock_t::time_point::max()};
+}
+
+/// @brief Create a budget that limits the time spent in a query.
+///
+/// The time limit starts counting when the budget is created.
+///
+/// @param time_limit The maximal duration, e.g. `std::chrono::milliseconds(2)`.
+/// @return A `tf::query_budget` instance.
+template <typename Rep, typename Period>
+auto make_query_budget(std::chrono::duration<Rep, Period> time_limit)
+    -> query_budget {
+  return query_budget{
+      std::numeric_limits<std::size_t>::max(),
+      query_budget::clock_t::now() +
+          std::chrono::duration_cast<query_budget::clock_t::duration>(
+              time_limit)};
+}
+
+/// @brief Create a budget that limits both node visits and time.
+///
+/// The time limit starts counting when the budget is created.
+///
+/// @param node_limit The maximal number of node visits.
+/// @param time_limit The maximal duration, e.g. `std::chrono::milliseconds(2)`.
+/// @return A `tf::query_budget` instance.
+template <typename Rep, typename Period>
+auto make_query_budget(std::size_t node_limit,
+                       std::chrono::duration<Rep, Period> time_limit)
+    -> query_budget {
+  return query_budget{
+      node_limit,
+      query_budget::clock_t::now() +
+          std::chrono::duration_cast<query_budget::clock_t::duration>(
+              time_limit)};
+}
+
+} // namespace tf
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./closest_point.hpp"
+#include "./distance.hpp"
+#include "./implementation/tree_radius_search.hpp"
+#include "./mod_tree.hpp"
+#include "./query_budget.hpp"
+#include "./tree.hpp"
+
+namespace tf {
+
+/// @brief Collect all primitives within a radius of an implicit query.
+///
+/// Traverses the tree, pruning nodes whose AABB metric exceeds `radius^2`, and
+/// appends the id and metric of every primitive with
+/// `closest_point_f(id).metric <= radius^2` to the output buffers.
+/// Results are not sorted.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius.
+/// @param ids Output buffer, primitive ids are appended to it.
+/// @param metrics Output buffer, metrics are appended to it.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto radius_search(const tf::tree<Index, RealT, N> &tree,
+                   const F0 &aabb_metric, const F1 &closest_point_f,
+                   RealT radius, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics) -> void {
+  tf::implementation::tree_radius_search(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, radius * radius,
+      [&](Index id, RealT metric) {
+        ids.push_back(id);
+        metrics.push_back(metric);
+      });
+}
+
+/// @brief Collect all primitives within a radius of an implicit query.
+///
+/// Traverses the tree, pruning nodes whose AABB metric exceeds `radius^2`, and
+/// appends the id and metric of every primitive with
+/// `closest_point_f(id).metric <= radius^2` to the output buffers.
+/// Results are not sorted.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius.
+/// @param ids Output buffer, primitive ids are appended to it.
+/// @param metrics Output buffer, metrics are appended to it.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto radius_search(const tf::mod_tree<Index, RealT, N> &tree,
+                   const F0 &aabb_metric, const F1 &closest_point_f,
+                   RealT radius, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics) -> void {
+  radius_search(tree.main_tree(), aabb_metric, closest_point_f, radius, ids,
+                metrics);
+  radius_search(tree.delta_tree(), aabb_metric, closest_point_f, radius, ids,
+                metrics);
+}
+
+/// @brief Collect primitives within a radius of an implicit query, on a budget.
+///
+/// As the unbudgeted overload, but the traversal stops when `budget` is
+/// exhausted. The primitives collected up to that point are kept. Use
+/// `budget.partial()` to check whether the results are complete.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius.
+/// @param ids Output buffer, primitive ids are appended to it.
+/// @param metrics Output buffer, metrics are appended to it.
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto radius_search(const tf::tree<Index, RealT, N> &tree,
+                   const F0 &aabb_metric, const F1 &closest_point_f,
+                   RealT radius, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics, const tf::query_budget &budget)
+    -> void {
+  tf::implementation::tree_radius_search(
+      tree.nodes(), tree.ids(), aabb_metric, closest_point_f, radius * radius,
+      [&](Index id, RealT metric) {
+        ids.push_back(id);
+        metrics.push_back(metric);
+      },
+      budget);
+}
+
+/// @brief Collect primitives within a radius of an implicit query, on a budget.
+///
+/// As the unbudgeted overload, but the traversal stops when `budget` is
+/// exhausted. The primitives collected up to that point are kept. Use
+/// `budget.partial()` to check whether the results are complete.
+///
+/// @param tree The spatial tree to query.
+/// @param aabb_metric A function that estimates the distance to a node's AABB.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance to a primitive.
+///                        Signature: `(Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius.
+/// @param ids Output buffer, primitive ids are appended to it.
+/// @param metrics Output buffer, metrics are appended to it.
+/// @param budget The node-visit and time budget, see @ref tf::query_budget.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto radius_search(const tf::mod_tree<Index, RealT, N> &tree,
+                   const F0 &aabb_metric, const F1 &closest_point_f,
+                   RealT radius, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics, const tf::query_budget &budget)
+    -> void {
+  radius_search(tree.main_tree(), aabb_metric, closest_point_f, radius, ids,
+                metrics, budget);
+  radius_search(tree.delta_tree(), aabb_metric, closest_point_f, radius, ids,
+                metrics, budget);
+}
+
+/// @brief Collect all points within a radius of a query point.
+///
+/// Convenience overload for trees built over a range of points.
+///
+/// @param tree The spatial tree built over `points`.
+/// @param points The range of points the tree was built over.
+/// @param query The query point.
+/// @param radius The search radius.
+/// @param ids Output buffer, point ids are appended to it.
+/// @param metrics Output buffer, squared distances are appended to it.
+template <typename Index, typename RealT, std::size_t N, typename Range>
+auto radius_search(const tf::tree<Index, RealT, N> &tree, const Range &points,
+                   const tf::vector<RealT, N> &query, RealT radius,
+                   tf::buffer<Index> &ids, tf::buffer<RealT> &metrics)
+    -> void {
+  radius_search(
+      tree,
+      [&query](const tf::aabb<RealT, N> &aabb) {
+        return tf::distance2(aabb, query);
+      },
+      [&query, &points](Index id) {
+        return tf::make_closest_point(tf::distance2(points[id], query),
+                                      points[id]);
+      },
+      radius, ids, metrics);
+}
+
+/// @brief Collect all primitives within a radius of each query, in parallel.
+///
+/// Queries are processed in parallel. Every thread appends its results into
+/// thread-local buffers, which are concatenated at the end. No locks or
+/// atomics are used on the hot path.
+///
+/// Results of query `i` are found at `[offsets[i], offsets[i + 1])` in `ids`
+/// and `metrics`. Use `tf::make_offset_block_range(offsets, ids)` for a
+/// range of per-query results.
+///
+/// @param tree The spatial tree to query.
+/// @param queries A random-access range of queries.
+/// @param aabb_metric A function that estimates the distance between a query and a node's AABB.
+///                    Signature: `(const Query& query, const tf::aabb<RealT, N>& aabb) -> RealT`
+/// @param closest_point_f A function that evaluates the true distance between a query and a primitive.
+///                        Signature: `(const Query& query, Index id) -> tf::closest_point<RealT, N>`
+/// @param radius The search radius.
+/// @param offsets Output offsets of size `queries.size() + 1`.
+/// @param ids Output primitive ids.
+/// @param metrics Output metrics.
+template <typename Index, typename RealT, std::size_t N, typename Range,
+          typename F0, typename F1>
+auto radius_search(const tf::tree<Index, RealT, N> &tree,
+                   const Range &queries, const F0 &aabb_metric,
+                   const F1 &closest_point_f, RealT radius,
+                   tf::buffer<Index> &offsets, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics) -> void {
+  tf::implementation::batched_radius_search<Index, RealT>(
+      queries.size(),
+      [&](std::size_t q, const auto &apply) {
+        const auto &query = queries[q];
+        tf::implementation::tree_radius_search(
+            tree.nodes(), tree.ids(),
+            [&](const tf::aabb<RealT, N> &aabb) {
+              return aabb_metric(query, aabb);
+            },
+            [&](Index id) { return closest_point_f(query, id); },
+            radius * radius, apply);
+      },
+      offsets, ids, metrics);
+}
+
+/// @brief Collect all points within a radius of each query point, in parallel.
+///
+/// Convenience overload for trees built over a range of points.
+/// Results of query `i` are found at `[offsets[i], offsets[i + 1])` in `ids`
+/// and `metrics`.
+///
+/// @param tree The spatial tree built over `points`.
+/// @param points The range of points the tree was built over.
+/// @param queries A random-access range of query points.
+/// @param radius The search radius.
+/// @param offsets Output offsets of size `queries.size() + 1`.
+/// @param ids Output point ids.
+/// @param metrics Output squared distances.
+template <typename Index, typename RealT, std::size_t N, typename Range0,
+          typename Range1>
+auto radius_search(const tf::tree<Index, RealT, N> &tree, const Range0 &points,
+                   const Range1 &queries, RealT radius,
+                   tf::buffer<Index> &offsets, tf::buffer<Index> &ids,
+                   tf::buffer<RealT> &metrics) -> void {
+  radius_search(
+      tree, queries,
+      [](const auto &query, const tf::aabb<RealT, N> &aabb) {
+        return tf::distance2(aabb, query);
+      },
+      [&points](const auto &query, Index id) {
+        return tf::make_closest_point(tf::distance2(points[id], query),
+                                      points[id]);
+      },
+      radius, offsets, ids, metrics);
+}
+} // namespace tf
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./vector.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace tf {
+
+/// @brief A ray with an origin and a direction.
+///
+/// Points on the ray are `origin + t * direction` for `t >= 0`. The direction
+/// need not be normalized, in which case ray parameters are measured in units
+/// of its length.
+///
+/// Use `tf::make_ray` to create an instance.
+///
+/// @tparam RealT The scalar coordinate type.
+/// @tparam Dims The spatial dimension.
+template <typename RealT, std::size_t Dims> struct ray {
+  vector<RealT, Dims> origin;
+  vector<RealT, Dims> direction;
+
+  /// @brief Return the point at ray parameter `t`.
+  auto point_at(RealT t) const -> vector<RealT, Dims> {
+    return origin + direction * t;
+  }
+};
+
+/// @brief Construct a ray from an origin and a direction.
+///
+/// @param origin The origin of the ray.
+/// @param direction The direction of the ray.
+/// @return A `tf::ray<RealT, Dims>` instance.
+template <typename RealT, std::size_t Dims>
+auto make_ray(const vector<RealT, Dims> &origin,
+              const vector<RealT, Dims> &direction) -> ray<RealT, Dims> {
+  return ray<RealT, Dims>{origin, direction};
+}
+
+/// @brief Compute the ray parameter at which a ray enters an AABB.
+///
+/// Uses the slab method. A ray starting inside the box enters it at `0`.
+/// The result is a lower bound on the ray parameter of any hit with a
+/// primitive inside the box, and may be used as an AABB metric in
+/// nearest-hit queries.
+///
+/// @param r The ray.
+/// @param box The box.
+/// @return The entry parameter, or `std::numeric_limits<RealT>::infinity()` if
+/// the ray misses the box.
+template <typename RealT, std::size_t Dims>
+auto ray_parameter(const ray<RealT, Dims> &r, const aabb<RealT, Dims> &box)
+    -> RealT {
+  RealT t_enter = 0;
+  RealT t_exit = std::numeric_limits<RealT>::infinity();
+  for (std::size_t i = 0; i < Dims; ++i) {
+    if (r.direction[i] == 0) {
+      if (r.origin[i] < box.min[i] || r.origin[i] > box.max[i])
+        return std::numeric_limits<RealT>::infinity();
+      continue;
+    }
+    auto inv_d = 1 / r.direction[i];
+    auto t0 = (box.min[i] - r.origin[i]) * inv_d;
+    auto t1 = (box.max[i] - r.origin[i]) * inv_d;
+    if (t0 > t1)
+      std::swap(t0, t1);
+    t_enter = std::max(t_enter, t0);
+    t_exit = std::min(t_exit, t1);
+  }
+  return t_enter <= t_exit ? t_enter : std::numeric_limits<RealT>::infinity();
+}
+
+/// @brief Compute the ray parameter at which a ray hits a triangle.
+///
+/// Uses the Möller–Trumbore algorithm. Both sides of the triangle are hit.
+///
+/// @param r The ray.
+/// @param triangle A range of three points.
+/// @return The ray parameter of the hit, or
+/// `std::numeric_limits<RealT>::infinity()` if the ray misses the triangle.
+template <typename RealT, typename Range>
+auto ray_triangle_parameter(const ray<RealT, 3> &r, const Range &triangle)
+    -> RealT {
+  auto cross = [](const auto &a, const auto &b) {
+    return vector<RealT, 3>{std::array<RealT, 3>{a[1] * b[2] - a[2] * b[1],
+                                                 a[2] * b[0] - a[0] * b[2],
+                                                 a[0] * b[1] - a[1] * b[0]}};
+  };
+  auto dot = [](const auto &a, const auto &b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  };
+  constexpr auto miss = std::numeric_limits<RealT>::infinity();
+  vector<RealT, 3> e1 = triangle[1] - triangle[0];
+  vector<RealT, 3> e2 = triangle[2] - triangle[0];
+  auto p = cross(r.direction, e2);
+  auto det = dot(e1, p);
+  if (det == 0)
+    return miss;
+  auto inv_det = 1 / det;
+  vector<RealT, 3> s = r.origin - triangle[0];
+  auto u = dot(s, p) * inv_det;
+  if (u < 0 || u > 1)
+    return miss;
+  auto q = cross(s, e1);
+  auto v = dot(r.direction, q) * inv_det;
+  if (v < 0 || u + v > 1)
+    return miss;
+  auto t = dot(e2, q) * inv_det;
+  return t >= 0 ? t : miss;
+}
+
+} // namespace tf
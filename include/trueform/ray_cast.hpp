@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/tree_closest_point.hpp"
+#include "./implementation/tree_closest_point_using_sort_by_level.hpp"
+#include "./mod_tree.hpp"
+#include "./ray.hpp"
+#include "./transformed.hpp"
+#include "./transformed_tree.hpp"
+#include "./tree.hpp"
+#include <limits>
+
+namespace tf {
+
+/// @brief Find the first primitive hit by a ray.
+///
+/// Nodes are visited in order of the ray parameter at which the ray enters
+/// their boxes (see `tf::ray_parameter`), and pruned once they are entered
+/// beyond the closest hit found, or missed.
+///
+/// @param tree The spatial tree to query.
+/// @param ray The query ray.
+/// @param ray_hit_f A function that intersects the ray with a primitive. The
+/// metric of the result is the ray parameter of the hit, or
+/// `std::numeric_limits<RealT>::infinity()` if the primitive is missed.
+///                  Signature: `(Index id) -> tf::closest_point<RealT, N>`
+///
+/// @return tf::tree_closest_point<Index, RealT, N>, where the metric is the
+/// ray parameter of the hit. Evaluates to `false` if nothing was hit.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto ray_cast(const tf::tree<Index, RealT, N> &tree,
+              const tf::ray<RealT, N> &ray, const F &ray_hit_f) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.nodes(), tree.ids(),
+      [&ray](const tf::aabb<RealT, N> &aabb) {
+        return tf::ray_parameter(ray, aabb);
+      },
+      ray_hit_f, result);
+  return result.point;
+}
+
+/// @brief Find the first primitive hit by a ray.
+///
+/// Nodes are visited in order of the ray parameter at which the ray enters
+/// their boxes (see `tf::ray_parameter`), and pruned once they are entered
+/// beyond the closest hit found, or missed.
+///
+/// @param tree The spatial tree to query.
+/// @param ray The query ray.
+/// @param ray_hit_f A function that intersects the ray with a primitive. The
+/// metric of the result is the ray parameter of the hit, or
+/// `std::numeric_limits<RealT>::infinity()` if the primitive is missed.
+///                  Signature: `(Index id) -> tf::closest_point<RealT, N>`
+///
+/// @return tf::tree_closest_point<Index, RealT, N>, where the metric is the
+/// ray parameter of the hit. Evaluates to `false` if nothing was hit.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto ray_cast(const tf::mod_tree<Index, RealT, N> &tree,
+              const tf::ray<RealT, N> &ray, const F &ray_hit_f) {
+  tf::implementation::tree_closest_point<Index, RealT, N> result{
+      std::numeric_limits<RealT>::max()};
+  auto aabb_metric = [&ray](const tf::aabb<RealT, N> &aabb) {
+    return tf::ray_parameter(ray, aabb);
+  };
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.main_tree().nodes(), tree.main_tree().ids(), aabb_metric, ray_hit_f,
+      result);
+  tf::implementation::tree_closest_point_using_sort_by_level(
+      tree.delta_tree().nodes(), tree.delta_tree().ids(), aabb_metric,
+      ray_hit_f, result);
+  return result.point;
+}
+
+/// @brief Find the first primitive of an instanced tree hit by a ray.
+///
+/// The world-space ray is transformed into the local frame of the tree once.
+/// As the transformation is rigid, ray parameters are the same in both
+/// frames. The hit point is reported in the world frame.
+///
+/// @param tree The transformed tree view.
+/// @param ray The query ray, in the world frame.
+/// @param ray_hit_f A function that intersects the local ray with a primitive.
+/// The metric of the result is the ray parameter of the hit, or
+/// `std::numeric_limits<RealT>::infinity()` if the primitive is missed.
+///                  Signature: `(Index id, const tf::ray<RealT, N>& local_ray)
+///                  -> tf::closest_point<RealT, N>`
+///
+/// @return tf::tree_closest_point<Index, RealT, N>, where the metric is the
+/// ray parameter of the hit. Evaluates to `false` if nothing was hit.
+template <typename Index, typename RealT, std::size_t N, typename F>
+auto ray_cast(const tf::transformed_tree<Index, RealT, N> &tree,
+              const tf::ray<RealT, N> &ray, const F &ray_hit_f) {
+  auto local_ray = tf::transformed(ray, tree.inverse_transformation());
+  auto result = ray_cast(tree.tree(), local_ray,
+                         [&](Index id) { return ray_hit_f(id, local_ray); });
+  if (result)
+    result.point.point =
+        tree.transformation().transform_point(result.point.point);
+  return result;
+}
+
+} // namespace tf
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./buffer.hpp"
+#include "./mod_tree.hpp"
+#include "./parallel_apply.hpp"
+#include "./transformation.hpp"
+#include "./transformed_tree.hpp"
+#include "./tree.hpp"
+#include "./tree_config.hpp"
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace tf {
+
+/// @brief A two-level acceleration structure over rigidly placed trees.
+///
+/// `tf::scene_tree` holds a set of instances (see @ref tf::transformed_tree),
+/// each referencing its own `tf::tree` in a local frame, and a top-level
+/// `tf::mod_tree` over the world AABBs of the instances.
+///
+/// Moving instances is cheap: `update` recomputes the world AABBs of the
+/// moved instances and moves them into the delta tree of the top level,
+/// while the per-instance trees are left untouched. Once the delta tree
+/// holds more than a quarter of the instances, the top level is rebuilt.
+///
+/// Use @ref tf::search_self to find pairs of intersecting primitives across
+/// instances. The broad phase runs on the top level, and the narrow phase
+/// runs a transform-aware dual search per pair of instances, in parallel.
+///
+/// @tparam Index The type used for instance and primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+/// @tparam N The spatial dimension.
+template <typename Index, typename RealT, std::size_t N> class scene_tree {
+public:
+  /// @brief Build the scene from a range of instances.
+  ///
+  /// @param instances A range of `tf::transformed_tree`. Instance ids are
+  /// their positions in the range.
+  template <typename Range> auto build(const Range &instances) -> void {
+    _instances.assign(instances.begin(), instances.end());
+    _aabbs.allocate(_instances.size());
+    tf::parallel_apply(std::forward_as_tuple(_instances, _aabbs),
+                       [](const auto &instance, auto &aabb) {
+                         aabb = instance.aabb();
+                       });
+    rebuild();
+  }
+
+  /// @brief Move instances to new poses.
+  ///
+  /// @param ids A range of ids of the moved instances.
+  /// @param transformations A range of their new transformations.
+  template <typename Range0, typename Range1>
+  auto update(const Range0 &ids, const Range1 &transformations) -> void {
+    _moved.allocate(_instances.size());
+    std::fill(_moved.begin(), _moved.end(), false);
+    for (std::size_t i = 0; i < std::size_t(ids.size()); ++i) {
+      auto id = ids[i];
+      _instances[id] = tf::make_transformed_tree(_instances[id].tree(),
+                                                 transformations[i]);
+      _aabbs[id] = _instances[id].aabb();
+      _moved[id] = true;
+    }
+    if (4 * (_top_tree.delta_tree().ids().size() + ids.size()) >
+        _instances.size()) {
+      rebuild();
+      return;
+    }
+    _top_tree.update(_aabbs, ids, [this](Index id) { return !_moved[id]; },
+                     config());
+  }
+
+  /// @brief Rebuild the top level from the current world AABBs.
+  auto rebuild() -> void { _top_tree.build(_aabbs, config()); }
+
+  /// @brief The instances of the scene.
+  auto instances() const
+      -> const std::vector<tf::transformed_tree<Index, RealT, N>> & {
+    return _instances;
+  }
+
+  /// @brief The world AABBs of the instances.
+  auto instance_aabbs() const -> const tf::buffer<tf::aabb<RealT, N>> & {
+    return _aabbs;
+  }
+
+  /// @brief The top-level tree over the world AABBs of the instances.
+  auto top_tree() const -> const tf::mod_tree<Index, RealT, N> & {
+    return _top_tree;
+  }
+
+  /// @brief Clear the scene.
+  auto clear() -> void {
+    _instances.clear();
+    _aabbs.clear();
+    _moved.clear();
+    _top_tree.clear();
+  }
+
+private:
+  static auto config() {
+    return tf::config_tree(
+        4, 4, [](const tf::aabb<RealT, N> &aabb) { return aabb; });
+  }
+
+  std::vector<tf::transformed_tree<Index, RealT, N>> _instances;
+  tf::buffer<tf::aabb<RealT, N>> _aabbs;
+  tf::buffer<bool> _moved;
+  tf::mod_tree<Index, RealT, N> _top_tree;
+};
+
+} // namespace tf
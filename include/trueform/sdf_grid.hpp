@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./buffer.hpp"
+#include "./mesh_pseudonormals.hpp"
+#include "./mod_tree.hpp"
+#include "./signed_distance.hpp"
+#include "./tree.hpp"
+#include "./vector.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace tf {
+
+/// @brief A regular grid of sample points, for @ref tf::sdf_grid.
+///
+/// Sample `(i, j, k)` is at `origin + spacing * (i, j, k)`, and is stored at
+/// `i + dims[0] * (j + dims[1] * k)`. When `band` is finite, only samples
+/// within `band` of the surface are computed exactly, and the rest are
+/// clamped to `-band` or `band`.
+///
+/// Use `tf::make_grid_spec` to create an instance.
+///
+/// @tparam RealT The real-valued coordinate type.
+template <typename RealT> struct grid_spec {
+  tf::vector<RealT, 3> origin;
+  RealT spacing;
+  std::array<int, 3> dims;
+  RealT band = std::numeric_limits<RealT>::max();
+
+  /// @brief The number of samples.
+  auto size() const -> std::size_t {
+    return std::size_t(dims[0]) * dims[1] * dims[2];
+  }
+};
+
+/// @brief Create a grid that covers an AABB with the given spacing.
+///
+/// @param aabb The box to cover, typically the root box of a tree, padded.
+/// @param spacing The distance between neighbouring samples.
+/// @param band The half-width of the narrow band. Unbounded by default.
+/// @return A `tf::grid_spec` instance.
+template <typename RealT>
+auto make_grid_spec(const tf::aabb<RealT, 3> &aabb, RealT spacing,
+                    RealT band = std::numeric_limits<RealT>::max())
+    -> grid_spec<RealT> {
+  grid_spec<RealT> spec;
+  spec.origin = aabb.min;
+  spec.spacing = spacing;
+  for (int i = 0; i < 3; ++i)
+    spec.dims[i] = int(std::ceil((aabb.max[i] - aabb.min[i]) / spacing)) + 1;
+  spec.band = band;
+  return spec;
+}
+
+} // namespace tf
+
+namespace tf::implementation {
+constexpr int sdf_brick_size = 8;
+
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1>
+auto sdf_brick(const Tree &tree, const Range0 &triangles, const Range1 &points,
+               const tf::mesh_pseudonormals<Index, RealT> &normals,
+               const tf::grid_spec<RealT> &spec,
+               const std::array<int, 3> &brick, RealT *out) -> void {
+  std::array<int, 3> lo, hi;
+  for (int d = 0; d < 3; ++d) {
+    lo[d] = brick[d] * sdf_brick_size;
+    hi[d] = std::min(lo[d] + sdf_brick_size, spec.dims[d]);
+  }
+  auto sample = [&spec](RealT i, RealT j, RealT k) {
+    return spec.origin + tf::make_vector<RealT, 3>({i, j, k}) * spec.spacing;
+  };
+  auto index = [&spec](int i, int j, int k) {
+    return i + std::size_t(spec.dims[0]) * (j + std::size_t(spec.dims[1]) * k);
+  };
+  auto fill = [&](RealT value) {
+    for (int k = lo[2]; k < hi[2]; ++k)
+      for (int j = lo[1]; j < hi[1]; ++j)
+        for (int i = lo[0]; i < hi[0]; ++i)
+          out[index(i, j, k)] = value;
+  };
+  auto band = spec.band;
+  bool has_band = band < std::numeric_limits<RealT>::max();
+  if (has_band) {
+    // every sample of the brick is at least |d(center)| - half_diagonal
+    // from the surface. If that is beyond the band, the surface does not
+    // cross the brick, and all samples share the sign of the center
+    auto center = sample(RealT(lo[0] + hi[0] - 1) / 2,
+                         RealT(lo[1] + hi[1] - 1) / 2,
+                         RealT(lo[2] + hi[2] - 1) / 2);
+    auto half_diagonal = (sample(hi[0] - 1, hi[1] - 1, hi[2] - 1) -
+                          sample(lo[0], lo[1], lo[2]))
+                             .length() /
+                         2;
+    auto result = signed_distance(tree, triangles, points, normals, center);
+    // an empty tree has no surface, every sample is outside
+    if (!result) {
+      fill(band);
+      return;
+    }
+    if (std::abs(result.distance) - half_diagonal > band) {
+      fill(result.distance < 0 ? -band : band);
+      return;
+    }
+  }
+  // the distance changes by at most `spacing` between neighbouring samples.
+  // With a band at least that wide, a sample beyond the band has the sign of
+  // its neighbour, as a change of sign would have to cross the band
+  bool has_sign_of_neighbour = band >= spec.spacing;
+  for (int k = lo[2]; k < hi[2]; ++k)
+    for (int j = lo[1]; j < hi[1]; ++j)
+      for (int i = lo[0]; i < hi[0]; ++i) {
+        auto query = sample(i, j, k);
+        auto result =
+            signed_distance(tree, triangles, points, normals, query, band);
+        if (result) {
+          out[index(i, j, k)] = std::clamp(result.distance, -band, band);
+          continue;
+        }
+        // beyond the band, only the sign is needed. The neighbour was
+        // already written by this brick
+        if (has_sign_of_neighbour && (i > lo[0] || j > lo[1] || k > lo[2])) {
+          auto neighbour = i > lo[0]   ? index(i - 1, j, k)
+                           : j > lo[1] ? index(i, j - 1, k)
+                                       : index(i, j, k - 1);
+          out[index(i, j, k)] = out[neighbour] < 0 ? -band : band;
+          continue;
+        }
+        result = signed_distance(tree, triangles, points, normals, query,
+                                 std::numeric_limits<RealT>::max());
+        if (!result) {
+          fill(band);
+          return;
+        }
+        out[index(i, j, k)] = result.distance < 0 ? -band : band;
+      }
+}
+
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1>
+auto sdf_grid(const Tree &tree, const Range0 &triangles, const Range1 &points,
+              const tf::mesh_pseudonormals<Index, RealT> &normals,
+              const tf::grid_spec<RealT> &spec) -> tf::buffer<RealT> {
+  tf::buffer<RealT> out;
+  out.allocate(spec.size());
+  std::array<int, 3> n_bricks;
+  for (int d = 0; d < 3; ++d)
+    n_bricks[d] = (spec.dims[d] + sdf_brick_size - 1) / sdf_brick_size;
+  std::size_t total = std::size_t(n_bricks[0]) * n_bricks[1] * n_bricks[2];
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, total, 1),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto b = range.begin(); b < range.end(); ++b) {
+          std::array<int, 3> brick = {
+              int(b % n_bricks[0]), int((b / n_bricks[0]) % n_bricks[1]),
+              int(b / (std::size_t(n_bricks[0]) * n_bricks[1]))};
+          sdf_brick(tree, triangles, points, normals, spec, brick,
+                    out.begin());
+        }
+      });
+  return out;
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Sample the signed distance to a closed triangle mesh on a grid.
+///
+/// The grid is split into bricks of 8³ samples, processed in parallel.
+/// With a narrow band, the
+/// distance from the center of a brick bounds the distances of all of its
+/// samples, so bricks that the band does not reach are filled with
+/// `-band` or `band` without further queries. The remaining queries only
+/// consider faces within the band. Samples beyond it are clamped to the band,
+/// with the sign of their neighbour. Signs are taken from the pseudonormals,
+/// as in @ref tf::signed_distance.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param normals The pseudonormals, built for `triangles` and `points`.
+/// @param spec The grid, see @ref tf::grid_spec.
+///
+/// @return tf::buffer<RealT> of `spec.size()` signed distances, with `x`
+/// varying fastest.
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto sdf_grid(const tf::tree<Index, RealT, 3> &tree, const Range0 &triangles,
+              const Range1 &points,
+              const tf::mesh_pseudonormals<Index, RealT> &normals,
+              const tf::grid_spec<RealT> &spec) -> tf::buffer<RealT> {
+  return tf::implementation::sdf_grid(tree, triangles, points, normals, spec);
+}
+
+/// @brief Sample the signed distance to a closed triangle mesh on a grid.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::buffer<RealT> of `spec.size()` signed distances, with `x`
+/// varying fastest.
+template <typename Index, typename RealT, typename Range0, typename Range1>
+auto sdf_grid(const tf::mod_tree<Index, RealT, 3> &tree,
+              const Range0 &triangles, const Range1 &points,
+              const tf::mesh_pseudonormals<Index, RealT> &normals,
+              const tf::grid_spec<RealT> &spec) -> tf::buffer<RealT> {
+  return tf::implementation::sdf_grid(tree, triangles, points, normals, spec);
+}
+
+} // namespace tf
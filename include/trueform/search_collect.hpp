@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./implementation/collect_pairs.hpp"
+#include "./mod_tree.hpp"
+#include "./search.hpp"
+#include "./tree.hpp"
+#include <array>
+
+namespace tf {
+
+namespace strategy {
+struct sorted_t {};
+static constexpr sorted_t sorted;
+} // namespace strategy
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(const tf::tree<Index, RealT, N> &tree0,
+                    const tf::tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(const tf::mod_tree<Index, RealT, N> &tree0,
+                    const tf::tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(const tf::tree<Index, RealT, N> &tree0,
+                    const tf::mod_tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(const tf::mod_tree<Index, RealT, N> &tree0,
+                    const tf::mod_tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The pairs are sorted lexicographically, making the result deterministic.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(strategy::sorted_t,
+                    const tf::tree<Index, RealT, N> &tree0,
+                    const tf::tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The pairs are sorted lexicographically, making the result deterministic.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(strategy::sorted_t,
+                    const tf::mod_tree<Index, RealT, N> &tree0,
+                    const tf::tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The pairs are sorted lexicographically, making the result deterministic.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(strategy::sorted_t,
+                    const tf::tree<Index, RealT, N> &tree0,
+                    const tf::mod_tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+
+/// @brief Collect all pairs of primitives between two spatial trees, in parallel.
+///
+/// Performs a parallel pairwise search (see @ref tf::search) and collects
+/// every pair of primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Pairs are pushed into thread-local buffers, which are
+/// concatenated in parallel at the end, so `primitive_check` need not
+/// synchronize.
+///
+/// The pairs are sorted lexicographically, making the result deterministic.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_collect(strategy::sorted_t,
+                    const tf::mod_tree<Index, RealT, N> &tree0,
+                    const tf::mod_tree<Index, RealT, N> &tree1,
+                    const F0 &check_aabbs, const F1 &primitive_check,
+                    int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search(
+            tree0, tree1, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+} // namespace tf
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/tree_count_search.hpp"
+#include "./mod_tree.hpp"
+#include "./search.hpp"
+#include "./tree.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace tf {
+
+/// @brief Count the pairs of primitives between two spatial trees, in
+/// parallel.
+///
+/// Counts the pairs of primitive IDs in intersecting leaves that pass
+/// `primitive_check`, as @ref tf::search_collect would collect them. Counts
+/// are accumulated per thread, without callbacks or synchronization.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_count(const tf::tree<Index, RealT, N> &tree0,
+                  const tf::tree<Index, RealT, N> &tree1,
+                  const F0 &check_aabbs, const F1 &primitive_check,
+                  int paralelism_depth = 6) -> std::size_t {
+  return tf::implementation::tree_count_search(
+      tree0.nodes(), tree0.ids(), tree1.nodes(), tree1.ids(), false,
+      check_aabbs, [](const auto &, const auto &) { return false; },
+      primitive_check, paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives between two spatial trees, in
+/// parallel, counting contained node pairs in bulk.
+///
+/// As the overload above, but pairs of nodes that pass `contains_aabbs` are
+/// not descended. All pairs of primitives below them are counted at once,
+/// from the sizes of the subtrees. For example, when counting pairs of points
+/// within distance `r`, a pair of nodes whose boxes are at most `r` apart at
+/// their farthest points (see @ref tf::maximal_distance) is counted in bulk.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param contains_aabbs Predicate that decides whether every pair of
+/// primitives within a pair of nodes passes `primitive_check`.
+///                       Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                       tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_count(const tf::tree<Index, RealT, N> &tree0,
+                  const tf::tree<Index, RealT, N> &tree1,
+                  const F0 &check_aabbs, const F1 &contains_aabbs,
+                  const F2 &primitive_check, int paralelism_depth = 6)
+    -> std::size_t {
+  return tf::implementation::tree_count_search(
+      tree0.nodes(), tree0.ids(), tree1.nodes(), tree1.ids(), false,
+      check_aabbs, contains_aabbs, primitive_check, paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives between two spatial trees, in
+/// parallel.
+///
+/// Counts the pairs of primitive IDs in intersecting leaves that pass
+/// `primitive_check`, over the main and delta trees of both. Counts are
+/// accumulated per thread, without callbacks or synchronization.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_count(const tf::mod_tree<Index, RealT, N> &tree0,
+                  const tf::mod_tree<Index, RealT, N> &tree1,
+                  const F0 &check_aabbs, const F1 &primitive_check,
+                  int paralelism_depth = 6) -> std::size_t {
+  return search_count(
+      tree0, tree1, check_aabbs,
+      [](const auto &, const auto &) { return false; }, primitive_check,
+      paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives between two spatial trees, in
+/// parallel, counting contained node pairs in bulk.
+///
+/// See the `tf::tree` overload. Bulk counts in the main tree are taken from
+/// its leaves, which skip the ids removed on update.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param contains_aabbs Predicate that decides whether every pair of
+/// primitives within a pair of nodes passes `primitive_check`.
+///                       Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                       tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_count(const tf::mod_tree<Index, RealT, N> &tree0,
+                  const tf::mod_tree<Index, RealT, N> &tree1,
+                  const F0 &check_aabbs, const F1 &contains_aabbs,
+                  const F2 &primitive_check, int paralelism_depth = 6)
+    -> std::size_t {
+  // leaves of the main trees may hold ids removed on update
+  auto count = [&](const auto &t0, bool is_main0, const auto &t1,
+                   bool is_main1) {
+    return tf::implementation::tree_count_search(
+        t0.nodes(), t0.ids(), t1.nodes(), t1.ids(), false, check_aabbs,
+        contains_aabbs, primitive_check, paralelism_depth, is_main0,
+        is_main1);
+  };
+  return count(tree0.main_tree(), true, tree1.main_tree(), true) +
+         count(tree0.main_tree(), true, tree1.delta_tree(), false) +
+         count(tree0.delta_tree(), false, tree1.main_tree(), true) +
+         count(tree0.delta_tree(), false, tree1.delta_tree(), false);
+}
+
+/// @brief Check whether any pair of primitives between two spatial trees
+/// passes `primitive_check`.
+///
+/// The search stops on all threads once a pair is found.
+///
+/// @param tree0 The first spatial tree.
+/// @param tree1 The second spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is a match.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return `true` if a pair was found.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_any(const tf::tree<Index, RealT, N> &tree0,
+                const tf::tree<Index, RealT, N> &tree1, const F0 &check_aabbs,
+                const F1 &primitive_check, int paralelism_depth = 6) -> bool {
+  std::atomic<bool> found{false};
+  tf::search(
+      tree0, tree1, check_aabbs,
+      [&](Index id0, Index id1) {
+        if (!primitive_check(id0, id1))
+          return false;
+        found.store(true, std::memory_order_relaxed);
+        return true;
+      },
+      [&found] { return found.load(std::memory_order_relaxed); },
+      paralelism_depth);
+  return found.load();
+}
+
+} // namespace tf
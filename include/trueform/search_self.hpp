@@ -4,8 +4,11 @@
  * https://github.com/xlabmedical/trueform
  */
 #pragma once
+#include "./implementation/tree_frontier_search.hpp"
 #include "./implementation/tree_self_search.hpp"
 #include "./mod_tree.hpp"
+#include "./pair_cache.hpp"
+#include "./search.hpp"
 #include "./tree.hpp"
 namespace tf {
 /// @brief Perform a parallel search of a spatial tree against itself.
@@ -21,7 +24,7 @@ namespace tf {
 ///                        Signature: `(Index id0, Index id1) -> bool`
 ///                        **Must be thread-safe** if it accesses shared memory.
 /// @param abort Function periodically called to determine if the search should
-/// be aborted.
+/// be aborted. A @ref tf::query_budget may be passed to bound the work.
 ///              Signature: `() -> bool`
 ///
 /// @return bool
@@ -59,7 +62,7 @@ auto search_self(const tf::tree<Index, RealT, N> &tree, const F0 &check_aabbs,
 ///                        Signature: `(Index id0, Index id1) -> bool`
 ///                        **Must be thread-safe** if it accesses shared memory.
 /// @param abort Function periodically called to determine if the search should
-/// be aborted.
+/// be aborted. A @ref tf::query_budget may be passed to bound the work.
 ///              Signature: `() -> bool`
 ///
 /// @return bool
@@ -68,11 +71,102 @@ template <typename Index, typename RealT, std::size_t N, typename F0,
 auto search_self(const tf::mod_tree<Index, RealT, N> &tree,
                  const F0 &check_aabbs, const F1 &primitive_apply,
                  const F2 &abort, int paralelism_depth = 6) -> bool {
-  if (!search_self(tree.main_tree(), check_aabbs, primitive_apply, abort,
-                   paralelism_depth))
-    return search_self(tree.delta_tree(), check_aabbs, primitive_apply, abort,
-                       paralelism_depth);
-  else
+  if (search_self(tree.main_tree(), check_aabbs, primitive_apply, abort,
+                  paralelism_depth))
     return true;
+  if (search_self(tree.delta_tree(), check_aabbs, primitive_apply, abort,
+                  paralelism_depth))
+    return true;
+  // pairs with one primitive in each of the trees
+  return search(tree.main_tree(), tree.delta_tree(), check_aabbs,
+                primitive_apply, abort, paralelism_depth);
+}
+
+/// @brief Perform a search of a spatial tree against itself, starting from
+/// the node pairs cached by the previous search.
+///
+/// Reports the same primitive pairs as the uncached @ref tf::search_self, but
+/// revalidates the front of node pairs stored in `cache` instead of starting
+/// at the root. Only pairs below nodes whose boxes changed since the last
+/// search are tested. See @ref tf::pair_cache.
+///
+/// @param cache The pair cache, updated by the search.
+/// @param tree The spatial tree.
+/// @param check_aabbs Monotone predicate that decides whether to recurse into
+/// a pair of nodes. Must give the same result for the same boxes in every
+/// call, or the cache must be cleared.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_apply Function called for each pair of primitive IDs in
+/// intersecting leaves.
+///                        Signature: `(Index id0, Index id1) -> bool`
+///                        **Must be thread-safe** if it accesses shared memory.
+/// @param abort Function periodically called to determine if the search should
+/// be aborted. An aborted search clears the cache.
+///              Signature: `() -> bool`
+///
+/// @return bool
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_self(tf::pair_cache<Index, RealT, N> &cache,
+                 const tf::tree<Index, RealT, N> &tree, const F0 &check_aabbs,
+                 const F1 &primitive_apply, const F2 &abort,
+                 int paralelism_depth = 6) -> bool {
+  return cache.search(
+      tree, tree, true, check_aabbs,
+      [&primitive_apply](const auto &ids0, const auto &ids1, bool is_self) {
+        for (Index i0 = 0; i0 < Index(ids0.size()); ++i0) {
+          auto id0 = ids0[i0];
+          for (Index i1 = (i0 + 1) * is_self; i1 < Index(ids1.size()); ++i1) {
+            auto id1 = ids1[i1];
+            if (primitive_apply(id0, id1))
+              return true;
+          }
+        }
+        return false;
+      },
+      abort, paralelism_depth);
+}
+
+/// @brief Perform a breadth-first search of a spatial tree against itself.
+///
+/// Reports the same primitive pairs as the depth-first @ref tf::search_self,
+/// processing one level of node pairs at a time, as flat arrays. It is not
+/// faster than the depth-first search. See the
+/// `tf::strategy::breadth_first` overload of @ref tf::search.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_apply Function called for each pair of primitive IDs in
+/// intersecting leaves.
+///                        Signature: `(Index id0, Index id1) -> bool`
+///                        **Must be thread-safe** if it accesses shared memory.
+/// @param abort Function periodically called to determine if the search should
+/// be aborted.
+///              Signature: `() -> bool`
+///
+/// @return bool
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_self(strategy::breadth_first_t,
+                 const tf::tree<Index, RealT, N> &tree, const F0 &check_aabbs,
+                 const F1 &primitive_apply, const F2 &abort) -> bool {
+  return tf::implementation::tree_frontier_search<Index>(
+      tree.nodes(), tree.ids(), tree.nodes(), tree.ids(), true, check_aabbs,
+      [&primitive_apply](const auto &ids0, const auto &ids1, bool is_self) {
+        for (Index i0 = 0; i0 < Index(ids0.size()); ++i0) {
+          auto id0 = ids0[i0];
+          for (Index i1 = (i0 + 1) * is_self; i1 < Index(ids1.size()); ++i1) {
+            auto id1 = ids1[i1];
+            if (primitive_apply(id0, id1))
+              return true;
+          }
+        }
+        return false;
+      },
+      abort);
 }
 } // namespace tf
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./implementation/collect_pairs.hpp"
+#include "./mod_tree.hpp"
+#include "./search_collect.hpp"
+#include "./search_self.hpp"
+#include "./tree.hpp"
+#include <algorithm>
+#include <array>
+
+namespace tf {
+
+/// @brief Collect all pairs of primitives within a spatial tree, in parallel.
+///
+/// Performs a parallel self search (see @ref tf::search_self) and collects
+/// every pair of distinct primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Each unordered pair is reported once. Pairs are pushed
+/// into thread-local buffers, which are concatenated in parallel at the end,
+/// so `primitive_check` need not synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_collect(const tf::tree<Index, RealT, N> &tree,
+                         const F0 &check_aabbs, const F1 &primitive_check,
+                         int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search_self(
+            tree, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives within a spatial tree, in parallel.
+///
+/// Performs a parallel self search (see @ref tf::search_self) and collects
+/// every pair of distinct primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Each unordered pair is reported once. Pairs are pushed
+/// into thread-local buffers, which are concatenated in parallel at the end,
+/// so `primitive_check` need not synchronize.
+///
+/// The order of the pairs is not deterministic. Use the
+/// `tf::strategy::sorted` overload for a sorted result.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_collect(const tf::mod_tree<Index, RealT, N> &tree,
+                         const F0 &check_aabbs, const F1 &primitive_check,
+                         int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search_self(
+            tree, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(id0, id1);
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      false);
+}
+
+/// @brief Collect all pairs of primitives within a spatial tree, in parallel.
+///
+/// Performs a parallel self search (see @ref tf::search_self) and collects
+/// every pair of distinct primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Each unordered pair is reported once. Pairs are pushed
+/// into thread-local buffers, which are concatenated in parallel at the end,
+/// so `primitive_check` need not synchronize.
+///
+/// Pairs are stored as `{min(id0, id1), max(id0, id1)}` and sorted
+/// lexicographically, making the result deterministic.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_collect(strategy::sorted_t,
+                         const tf::tree<Index, RealT, N> &tree,
+                         const F0 &check_aabbs, const F1 &primitive_check,
+                         int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search_self(
+            tree, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(std::min(id0, id1), std::max(id0, id1));
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+
+/// @brief Collect all pairs of primitives within a spatial tree, in parallel.
+///
+/// Performs a parallel self search (see @ref tf::search_self) and collects
+/// every pair of distinct primitive IDs in intersecting leaves that passes
+/// `primitive_check`. Each unordered pair is reported once. Pairs are pushed
+/// into thread-local buffers, which are concatenated in parallel at the end,
+/// so `primitive_check` need not synchronize.
+///
+/// Pairs are stored as `{min(id0, id1), max(id0, id1)}` and sorted
+/// lexicographically, making the result deterministic.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is collected.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return tf::buffer<std::array<Index, 2>> of `{id0, id1}` pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_collect(strategy::sorted_t,
+                         const tf::mod_tree<Index, RealT, N> &tree,
+                         const F0 &check_aabbs, const F1 &primitive_check,
+                         int paralelism_depth = 6)
+    -> tf::buffer<std::array<Index, 2>> {
+  return tf::implementation::collect_pairs<Index>(
+      [&](const auto &apply) {
+        tf::search_self(
+            tree, check_aabbs,
+            [&](Index id0, Index id1) {
+              if (primitive_check(id0, id1))
+                apply(std::min(id0, id1), std::max(id0, id1));
+              return false;
+            },
+            [] { return false; }, paralelism_depth);
+      },
+      true);
+}
+} // namespace tf
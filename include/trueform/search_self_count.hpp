@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./implementation/tree_count_search.hpp"
+#include "./mod_tree.hpp"
+#include "./search_count.hpp"
+#include "./search_self.hpp"
+#include "./tree.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace tf {
+
+/// @brief Count the pairs of primitives within a spatial tree, in parallel.
+///
+/// Counts the pairs of distinct primitive IDs in intersecting leaves that
+/// pass `primitive_check`, as @ref tf::search_self_collect would collect
+/// them. Each unordered pair is counted once. Counts are accumulated per
+/// thread, without callbacks or synchronization.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_count(const tf::tree<Index, RealT, N> &tree,
+                       const F0 &check_aabbs, const F1 &primitive_check,
+                       int paralelism_depth = 6) -> std::size_t {
+  return tf::implementation::tree_count_search(
+      tree.nodes(), tree.ids(), tree.nodes(), tree.ids(), true, check_aabbs,
+      [](const auto &, const auto &) { return false; }, primitive_check,
+      paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives within a spatial tree, in parallel,
+/// counting contained node pairs in bulk.
+///
+/// As the overload above, but pairs of nodes that pass `contains_aabbs` are
+/// not descended. All pairs of distinct primitives below them are counted at
+/// once, from the sizes of the subtrees.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param contains_aabbs Predicate that decides whether every pair of
+/// primitives within a pair of nodes passes `primitive_check`.
+///                       Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                       tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_self_count(const tf::tree<Index, RealT, N> &tree,
+                       const F0 &check_aabbs, const F1 &contains_aabbs,
+                       const F2 &primitive_check, int paralelism_depth = 6)
+    -> std::size_t {
+  return tf::implementation::tree_count_search(
+      tree.nodes(), tree.ids(), tree.nodes(), tree.ids(), true, check_aabbs,
+      contains_aabbs, primitive_check, paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives within a spatial tree, in parallel.
+///
+/// Counts over the main tree, the delta tree, and the pairs between them.
+/// Each unordered pair is counted once.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_count(const tf::mod_tree<Index, RealT, N> &tree,
+                       const F0 &check_aabbs, const F1 &primitive_check,
+                       int paralelism_depth = 6) -> std::size_t {
+  return search_self_count(tree, check_aabbs,
+                           [](const auto &, const auto &) { return false; },
+                           primitive_check, paralelism_depth);
+}
+
+/// @brief Count the pairs of primitives within a spatial tree, in parallel,
+/// counting contained node pairs in bulk.
+///
+/// See the `tf::tree` overload. Bulk counts in the main tree are taken from
+/// its leaves, which skip the ids removed on update.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param contains_aabbs Predicate that decides whether every pair of
+/// primitives within a pair of nodes passes `primitive_check`.
+///                       Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                       tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is counted.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return The number of pairs.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1, typename F2>
+auto search_self_count(const tf::mod_tree<Index, RealT, N> &tree,
+                       const F0 &check_aabbs, const F1 &contains_aabbs,
+                       const F2 &primitive_check, int paralelism_depth = 6)
+    -> std::size_t {
+  // leaves of the main tree may hold ids removed on update
+  const auto &main = tree.main_tree();
+  const auto &delta = tree.delta_tree();
+  return tf::implementation::tree_count_search(
+             main.nodes(), main.ids(), main.nodes(), main.ids(), true,
+             check_aabbs, contains_aabbs, primitive_check, paralelism_depth,
+             true, true) +
+         search_self_count(delta, check_aabbs, contains_aabbs,
+                           primitive_check, paralelism_depth) +
+         tf::implementation::tree_count_search(
+             main.nodes(), main.ids(), delta.nodes(), delta.ids(), false,
+             check_aabbs, contains_aabbs, primitive_check, paralelism_depth,
+             true, false);
+}
+
+/// @brief Check whether any pair of distinct primitives within a spatial
+/// tree passes `primitive_check`.
+///
+/// The search stops on all threads once a pair is found.
+///
+/// @param tree The spatial tree.
+/// @param check_aabbs Predicate that decides whether to recurse into a pair of
+/// nodes.
+///                    Signature: `(const tf::aabb<RealT, N>& aabb0, const
+///                    tf::aabb<RealT, N>& aabb1) -> bool`
+/// @param primitive_check Predicate that decides whether a pair of primitive
+/// IDs is a match.
+///                        Signature: `(Index id0, Index id1) -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return `true` if a pair was found.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self_any(const tf::tree<Index, RealT, N> &tree,
+                     const F0 &check_aabbs, const F1 &primitive_check,
+                     int paralelism_depth = 6) -> bool {
+  std::atomic<bool> found{false};
+  tf::search_self(
+      tree, check_aabbs,
+      [&](Index id0, Index id1) {
+        if (!primitive_check(id0, id1))
+          return false;
+        found.store(true, std::memory_order_relaxed);
+        return true;
+      },
+      [&found] { return found.load(std::memory_order_relaxed); },
+      paralelism_depth);
+  return found.load();
+}
+
+} // namespace tf
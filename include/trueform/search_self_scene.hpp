@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./intersects.hpp"
+#include "./scene_tree.hpp"
+#include "./search.hpp"
+#include "./search_self_collect.hpp"
+#include "tbb/parallel_for.h"
+#include <atomic>
+
+namespace tf {
+
+/// @brief Search a scene for pairs of primitives of different instances.
+///
+/// Runs in two phases:
+/// - the broad phase collects pairs of instances whose world AABBs are within
+///   `epsilon`, by a parallel self search of the top level
+///   (see @ref tf::search_self_collect),
+/// - the narrow phase searches the trees of every such pair with the
+///   transform-aware dual @ref tf::search, under the relative transformation
+///   of the two instances. Pairs of instances are processed in parallel.
+///
+/// Pairs of primitives within the same instance are not reported.
+///
+/// @param scene The scene.
+/// @param epsilon Tolerance, nodes closer than `epsilon` are traversed.
+/// @param primitive_apply Function called for each pair of primitive IDs in
+/// intersecting leaves of two instances.
+///                        Signature: `(Index instance0, Index instance1,
+///                        Index id0, Index id1, const
+///                        tf::transformation<RealT, N>& relative) -> bool`,
+///                        where `relative` maps the local frame of `instance1`
+///                        into the local frame of `instance0`. Return `true`
+///                        to abort the search.
+///                        **Must be thread-safe** if it accesses shared memory.
+/// @param abort Function periodically called to determine if the search should
+/// be aborted.
+///              Signature: `() -> bool`
+/// @param paralelism_depth Set to 0 to run serially. Otherwise, node pairs
+/// are split into parallel tasks where there is work and idle threads.
+///
+/// @return `true` if `primitive_apply` aborted the search.
+template <typename Index, typename RealT, std::size_t N, typename F0,
+          typename F1>
+auto search_self(const tf::scene_tree<Index, RealT, N> &scene, RealT epsilon,
+                 const F0 &primitive_apply, const F1 &abort,
+                 int paralelism_depth = 2) -> bool {
+  const auto &aabbs = scene.instance_aabbs();
+  auto instance_pairs = tf::search_self_collect(
+      scene.top_tree(),
+      [epsilon](const tf::aabb<RealT, N> &aabb0,
+                const tf::aabb<RealT, N> &aabb1) {
+        return tf::intersects(aabb0, aabb1, epsilon);
+      },
+      [&aabbs, epsilon](Index id0, Index id1) {
+        return tf::intersects(aabbs[id0], aabbs[id1], epsilon);
+      });
+  std::atomic<bool> found{false};
+  auto stop = [&found, &abort] {
+    return found.load(std::memory_order_relaxed) || abort();
+  };
+  const auto &instances = scene.instances();
+  tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, instance_pairs.size(), 1),
+      [&](const tbb::blocked_range<std::size_t> &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+          if (stop())
+            return;
+          auto [instance0, instance1] = instance_pairs[i];
+          if (tf::search(
+                  instances[instance0], instances[instance1], epsilon,
+                  [&, instance0 = instance0, instance1 = instance1](
+                      Index id0, Index id1,
+                      const tf::transformation<RealT, N> &relative) {
+                    return primitive_apply(instance0, instance1, id0, id1,
+                                           relative);
+                  },
+                  stop, paralelism_depth))
+            found.store(true, std::memory_order_relaxed);
+        }
+      });
+  return found.load();
+}
+
+} // namespace tf
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./buffer.hpp"
+#include "./closest_feature_on_triangle.hpp"
+#include "./closest_point.hpp"
+#include "./closest_point_on_triangle.hpp"
+#include "./distance.hpp"
+#include "./dot.hpp"
+#include "./indirect_range.hpp"
+#include "./mesh_pseudonormals.hpp"
+#include "./mod_tree.hpp"
+#include "./nearness_search.hpp"
+#include "./tree.hpp"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace tf {
+
+/// @brief Result of a signed distance query against a triangle mesh.
+///
+/// Holds the closest face, the closest point on it, the feature of the
+/// face it lies on, and the signed distance: negative inside the mesh and
+/// positive outside.
+///
+/// @tparam Index The type used for primitive identifiers.
+/// @tparam RealT The scalar coordinate type.
+template <typename Index, typename RealT> struct tree_signed_distance {
+  static constexpr Index no_id = -1;
+  Index element;
+  RealT distance;
+  tf::vector<RealT, 3> point;
+  tf::triangle_feature feature;
+  std::int8_t feature_id;
+
+  operator bool() const { return element != no_id; }
+};
+
+} // namespace tf
+
+namespace tf::implementation {
+// Only faces within `radius` are considered, and the result is empty if
+// there are none.
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1, typename Point>
+auto signed_distance(const Tree &tree, const Range0 &triangles,
+                     const Range1 &points,
+                     const tf::mesh_pseudonormals<Index, RealT> &normals,
+                     const Point &query, RealT radius)
+    -> tf::tree_signed_distance<Index, RealT> {
+  auto q = tf::make_vector<RealT, 3>(
+      {RealT(query[0]), RealT(query[1]), RealT(query[2])});
+  auto aabb_metric = [&q](const tf::aabb<RealT, 3> &aabb) {
+    return tf::distance2(aabb, q);
+  };
+  auto closest_point_f = [&](Index id) {
+    auto cpt = tf::closest_point_on_triangle(
+        tf::make_indirect_range(triangles[id], points), q);
+    return tf::make_closest_point((cpt - q).length2(), cpt);
+  };
+  auto closest =
+      radius < std::numeric_limits<RealT>::max()
+          ? tf::nearness_search(tree, aabb_metric, closest_point_f, radius)
+          : tf::nearness_search(tree, aabb_metric, closest_point_f);
+  tf::tree_signed_distance<Index, RealT> out;
+  out.element = out.no_id;
+  if (!closest)
+    return out;
+  // the feature of the winning face only
+  auto feature = tf::closest_feature_on_triangle(
+      tf::make_indirect_range(triangles[closest.element], points), q);
+  auto d = q - feature.point;
+  auto distance = d.length();
+  const auto &normal = normals.normal(triangles, closest.element, feature);
+  out.element = closest.element;
+  out.distance = tf::dot(d, normal) < 0 ? -distance : distance;
+  out.point = feature.point;
+  out.feature = feature.feature;
+  out.feature_id = feature.id;
+  return out;
+}
+
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1, typename Point>
+auto signed_distance(const Tree &tree, const Range0 &triangles,
+                     const Range1 &points,
+                     const tf::mesh_pseudonormals<Index, RealT> &normals,
+                     const Point &query)
+    -> tf::tree_signed_distance<Index, RealT> {
+  return signed_distance(tree, triangles, points, normals, query,
+                         std::numeric_limits<RealT>::max());
+}
+
+template <typename Index, typename RealT, typename Tree, typename Range0,
+          typename Range1, typename Range2>
+auto signed_distances(const Tree &tree, const Range0 &triangles,
+                      const Range1 &points,
+                      const tf::mesh_pseudonormals<Index, RealT> &normals,
+                      const Range2 &queries)
+    -> tf::buffer<tf::tree_signed_distance<Index, RealT>> {
+  tf::buffer<tf::tree_signed_distance<Index, RealT>> out;
+  out.allocate(queries.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, queries.size(), 64),
+                    [&](const tbb::blocked_range<std::size_t> &range) {
+                      for (auto i = range.begin(); i < range.end(); ++i)
+                        out[i] = signed_distance(tree, triangles, points,
+                                                 normals, queries[i]);
+                    });
+  return out;
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Compute the signed distance from a point to a closed triangle
+/// mesh.
+///
+/// Finds the closest face with @ref tf::nearness_search, then the feature
+/// (vertex, edge or face) of the closest point on it with
+/// @ref tf::closest_feature_on_triangle. The sign is taken from the
+/// angle-weighted pseudonormal of that feature, which is reliable at edges
+/// and vertices, where the normal of the closest face alone is not.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param normals The pseudonormals, built for `triangles` and `points`.
+/// @param query The query point.
+///
+/// @return tf::tree_signed_distance<Index, RealT>.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Point>
+auto signed_distance(const tf::tree<Index, RealT, 3> &tree,
+                     const Range0 &triangles, const Range1 &points,
+                     const tf::mesh_pseudonormals<Index, RealT> &normals,
+                     const Point &query)
+    -> tf::tree_signed_distance<Index, RealT> {
+  return tf::implementation::signed_distance(tree, triangles, points, normals,
+                                             query);
+}
+
+/// @brief Compute the signed distance from a point to a closed triangle
+/// mesh.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::tree_signed_distance<Index, RealT>.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Point>
+auto signed_distance(const tf::mod_tree<Index, RealT, 3> &tree,
+                     const Range0 &triangles, const Range1 &points,
+                     const tf::mesh_pseudonormals<Index, RealT> &normals,
+                     const Point &query)
+    -> tf::tree_signed_distance<Index, RealT> {
+  return tf::implementation::signed_distance(tree, triangles, points, normals,
+                                             query);
+}
+
+/// @brief Compute the signed distances from many points to a closed
+/// triangle mesh, in parallel.
+///
+/// See @ref tf::signed_distance.
+///
+/// @param tree The spatial tree built over `triangles`.
+/// @param triangles A range of triangles, each a range of three point
+/// indices.
+/// @param points The points indexed by the triangles.
+/// @param normals The pseudonormals, built for `triangles` and `points`.
+/// @param queries A range of query points.
+///
+/// @return tf::buffer<tf::tree_signed_distance<Index, RealT>>, one per query.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2>
+auto signed_distances(const tf::tree<Index, RealT, 3> &tree,
+                      const Range0 &triangles, const Range1 &points,
+                      const tf::mesh_pseudonormals<Index, RealT> &normals,
+                      const Range2 &queries)
+    -> tf::buffer<tf::tree_signed_distance<Index, RealT>> {
+  return tf::implementation::signed_distances(tree, triangles, points, normals,
+                                              queries);
+}
+
+/// @brief Compute the signed distances from many points to a closed
+/// triangle mesh, in parallel.
+///
+/// Searches the main and the delta tree. See the `tf::tree` overload.
+///
+/// @return tf::buffer<tf::tree_signed_distance<Index, RealT>>, one per query.
+template <typename Index, typename RealT, typename Range0, typename Range1,
+          typename Range2>
+auto signed_distances(const tf::mod_tree<Index, RealT, 3> &tree,
+                      const Range0 &triangles, const Range1 &points,
+                      const tf::mesh_pseudonormals<Index, RealT> &normals,
+                      const Range2 &queries)
+    -> tf::buffer<tf::tree_signed_distance<Index, RealT>> {
+  return tf::implementation::signed_distances(tree, triangles, points, normals,
+                                              queries);
+}
+
+} // namespace tf
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include <algorithm>
+
+namespace tf {
+
+/// @brief A closed interval of time, `[min, max]`.
+///
+/// An interval with `min > max` is empty.
+///
+/// @tparam RealT The scalar type.
+template <typename RealT> struct time_interval {
+  RealT min;
+  RealT max;
+
+  /// @brief Check whether the interval is non-empty.
+  explicit operator bool() const { return min <= max; }
+};
+
+/// @brief Construct a time interval.
+template <typename RealT>
+auto make_time_interval(RealT min, RealT max) -> time_interval<RealT> {
+  return time_interval<RealT>{min, max};
+}
+
+/// @brief Bound the times at which two moving boxes are within epsilon.
+///
+/// Each box moves linearly over `[0, 1]`, from its box at time `0` to its box
+/// at time `1` (see @ref tf::motion). On every axis, the overlap condition is
+/// linear in time, so the interval is exact for the blended boxes, and
+/// conservative for anything they bound.
+///
+/// @param aabb0_from The first box at time `0`.
+/// @param aabb0_to The first box at time `1`.
+/// @param aabb1_from The second box at time `0`.
+/// @param aabb1_to The second box at time `1`.
+/// @param epsilon Tolerance, boxes closer than `epsilon` overlap.
+/// @return The interval within `[0, 1]`, empty if the boxes never overlap.
+template <typename RealT, std::size_t Dims>
+auto impact_interval(const tf::aabb<RealT, Dims> &aabb0_from,
+                     const tf::aabb<RealT, Dims> &aabb0_to,
+                     const tf::aabb<RealT, Dims> &aabb1_from,
+                     const tf::aabb<RealT, Dims> &aabb1_to, RealT epsilon = 0)
+    -> time_interval<RealT> {
+  time_interval<RealT> out{0, 1};
+  // keeps the times at which c + t * k <= 0
+  auto clip = [&out](RealT c, RealT k) {
+    if (k > 0)
+      out.max = std::min(out.max, -c / k);
+    else if (k < 0)
+      out.min = std::max(out.min, -c / k);
+    else if (c > 0)
+      out.max = -1;
+  };
+  for (std::size_t i = 0; i < Dims; ++i) {
+    // min0(t) <= max1(t) + epsilon
+    auto c = aabb0_from.min[i] - aabb1_from.max[i] - epsilon;
+    clip(c, aabb0_to.min[i] - aabb1_to.max[i] - epsilon - c);
+    // min1(t) <= max0(t) + epsilon
+    c = aabb1_from.min[i] - aabb0_from.max[i] - epsilon;
+    clip(c, aabb1_to.min[i] - aabb0_to.max[i] - epsilon - c);
+    if (!out)
+      break;
+  }
+  return out;
+}
+
+} // namespace tf
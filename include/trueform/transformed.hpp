@@ -5,6 +5,7 @@
  */
 #pragma once
 #include "./aabb.hpp"
+#include "./ray.hpp"
 #include "./transformation.hpp"
 
 namespace tf {
@@ -77,4 +78,22 @@ auto transformed(const aabb<T, Dims> &_this,
   }
   return out;
 }
+
+/// @brief Apply a transformation to a ray.
+///
+/// The origin is transformed as a point and the direction as a vector. Under
+/// a rigid transformation, ray parameters are preserved.
+///
+/// @tparam T Scalar type of the input ray.
+/// @tparam Dims Dimensionality of the ray and transformation.
+/// @tparam U Scalar type of the transformation matrix.
+/// @param _this The input ray to be transformed.
+/// @param transform The affine transformation to apply.
+/// @return The transformed ray.
+template <typename T, std::size_t Dims, typename U>
+auto transformed(const ray<T, Dims> &_this,
+                 const transformation<U, Dims> &transform) {
+  return make_ray(transform.transform_point(_this.origin),
+                  transform.transform_vector(_this.direction));
+}
 } // namespace tf
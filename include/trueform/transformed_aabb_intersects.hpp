@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./transformation.hpp"
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace tf {
+
+/// @brief Intersection test between an AABB and a rigidly transformed AABB.
+///
+/// Tests whether `aabb0` intersects `aabb1` under a rigid transformation
+/// (rotation and translation), treating the transformed `aabb1` as an
+/// oriented bounding box. Unlike `tf::intersects(aabb0,
+/// tf::transformed(aabb1, transformation))`, the transformed box is not
+/// loosened into an AABB, which avoids over-refinement in dual searches.
+///
+/// The absolute rotation is computed once, at construction. Each test is a
+/// separating axis test with 15 axes in 3D (the face normals of both boxes and
+/// their 9 cross products) and 4 axes in 2D. Other dimensions test the face
+/// normals only, which is conservative.
+///
+/// Use `tf::make_transformed_aabb_intersects` to create an instance.
+///
+/// @tparam RealT The scalar coordinate type.
+/// @tparam Dims The spatial dimension.
+template <typename RealT, std::size_t Dims> class transformed_aabb_intersects {
+public:
+  transformed_aabb_intersects(const tf::transformation<RealT, Dims> &transform,
+                              RealT epsilon = 0)
+      : transform{transform}, epsilon{epsilon} {
+    // guards against parallel axes, where cross
+    // products degenerate and round-off dominates
+    constexpr RealT slack = 16 * std::numeric_limits<RealT>::epsilon();
+    for (std::size_t i = 0; i < Dims; ++i)
+      for (std::size_t j = 0; j < Dims; ++j)
+        abs_rotation[i][j] = std::abs(transform(i, j)) + slack;
+  }
+
+  /// @brief Check whether `aabb0` intersects the transformed `aabb1`.
+  ///
+  /// @param aabb0 A box in the frame of the result of the transformation.
+  /// @param aabb1 A box that is transformed.
+  /// @return `true` if the boxes intersect within epsilon.
+  auto operator()(const tf::aabb<RealT, Dims> &aabb0,
+                  const tf::aabb<RealT, Dims> &aabb1) const -> bool {
+    std::array<RealT, Dims> e0;
+    std::array<RealT, Dims> e1;
+    std::array<RealT, Dims> c1;
+    for (std::size_t i = 0; i < Dims; ++i) {
+      e0[i] = (aabb0.max[i] - aabb0.min[i]) / 2 + epsilon;
+      e1[i] = (aabb1.max[i] - aabb1.min[i]) / 2;
+      c1[i] = (aabb1.max[i] + aabb1.min[i]) / 2;
+    }
+    // center of aabb1 relative to the center of aabb0, in the frame of aabb0
+    std::array<RealT, Dims> t;
+    for (std::size_t i = 0; i < Dims; ++i) {
+      t[i] = transform(i, Dims) - (aabb0.max[i] + aabb0.min[i]) / 2;
+      for (std::size_t j = 0; j < Dims; ++j)
+        t[i] += transform(i, j) * c1[j];
+    }
+    // face normals of aabb0
+    for (std::size_t i = 0; i < Dims; ++i) {
+      RealT r1 = 0;
+      for (std::size_t j = 0; j < Dims; ++j)
+        r1 += abs_rotation[i][j] * e1[j];
+      if (std::abs(t[i]) > e0[i] + r1)
+        return false;
+    }
+    // face normals of aabb1
+    for (std::size_t j = 0; j < Dims; ++j) {
+      RealT r0 = 0;
+      RealT d = 0;
+      for (std::size_t i = 0; i < Dims; ++i) {
+        r0 += abs_rotation[i][j] * e0[i];
+        d += transform(i, j) * t[i];
+      }
+      if (std::abs(d) > r0 + e1[j])
+        return false;
+    }
+    if constexpr (Dims == 3) {
+      // cross products of face normals
+      for (std::size_t i = 0; i < 3; ++i) {
+        auto i1 = (i + 1) % 3;
+        auto i2 = (i + 2) % 3;
+        for (std::size_t j = 0; j < 3; ++j) {
+          auto j1 = (j + 1) % 3;
+          auto j2 = (j + 2) % 3;
+          auto d = t[i2] * transform(i1, j) - t[i1] * transform(i2, j);
+          auto r0 = e0[i1] * abs_rotation[i2][j] + e0[i2] * abs_rotation[i1][j];
+          auto r1 = e1[j1] * abs_rotation[i][j2] + e1[j2] * abs_rotation[i][j1];
+          if (std::abs(d) > r0 + r1)
+            return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// @brief The transformation applied to the second box.
+  auto transformation() const -> const tf::transformation<RealT, Dims> & {
+    return transform;
+  }
+
+private:
+  tf::transformation<RealT, Dims> transform;
+  std::array<std::array<RealT, Dims>, Dims> abs_rotation;
+  RealT epsilon;
+};
+
+/// @brief Create an intersection test between AABBs and rigidly transformed AABBs.
+///
+/// @param transformation A rigid transformation (rotation and translation).
+/// @param epsilon Tolerance, boxes closer than `epsilon` are considered intersecting.
+/// @return A `tf::transformed_aabb_intersects` instance.
+template <typename RealT, std::size_t Dims>
+auto make_transformed_aabb_intersects(
+    const tf::transformation<RealT, Dims> &transformation, RealT epsilon = 0)
+    -> transformed_aabb_intersects<RealT, Dims> {
+  return transformed_aabb_intersects<RealT, Dims>{transformation, epsilon};
+}
+
+} // namespace tf
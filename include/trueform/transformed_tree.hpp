@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./aabb.hpp"
+#include "./inverted.hpp"
+#include "./transformation.hpp"
+#include "./transformed.hpp"
+#include "./tree.hpp"
+#include <limits>
+
+namespace tf {
+
+/// @brief A view of a `tf::tree` placed in the world by a rigid transformation.
+///
+/// `tf::transformed_tree` pairs a tree, built once in the local frame of its
+/// primitives, with a transformation from the local frame into the world. The
+/// same tree can then serve many instances at different poses, without
+/// rebuilding or copying it.
+///
+/// Queries on the view (@ref tf::search, @ref tf::nearness_search and
+/// @ref tf::ray_cast) transform the query into the local frame once, instead
+/// of transforming every visited node box. Primitive callbacks receive the
+/// query in the local frame, and results are reported in the world frame.
+///
+/// The transformation must be rigid (rotation and translation), so that
+/// distances and ray parameters are the same in both frames. The view stores
+/// a pointer to the tree, which must outlive it.
+///
+/// Use `tf::make_transformed_tree` to create an instance.
+///
+/// @tparam Index The type used for primitive identifiers.
+/// @tparam RealT The real-valued coordinate type.
+/// @tparam N The spatial dimension.
+template <typename Index, typename RealT, std::size_t N>
+class transformed_tree {
+public:
+  transformed_tree(const tf::tree<Index, RealT, N> &tree,
+                   const tf::transformation<RealT, N> &transformation)
+      : _tree{&tree}, _transformation{transformation},
+        _inverse_transformation{tf::inverted(transformation)} {}
+
+  /// @brief The underlying tree, in the local frame.
+  auto tree() const -> const tf::tree<Index, RealT, N> & { return *_tree; }
+
+  /// @brief The transformation from the local frame into the world.
+  auto transformation() const -> const tf::transformation<RealT, N> & {
+    return _transformation;
+  }
+
+  /// @brief The transformation from the world into the local frame.
+  auto inverse_transformation() const -> const tf::transformation<RealT, N> & {
+    return _inverse_transformation;
+  }
+
+  /// @brief The AABB of the instance in the world frame.
+  ///
+  /// Conservative, as it bounds the transformed root box. An empty tree
+  /// gives an inverted box, with `min` above `max`, that overlaps nothing.
+  auto aabb() const -> tf::aabb<RealT, N> {
+    if (!_tree->nodes().size()) {
+      tf::aabb<RealT, N> out;
+      for (std::size_t d = 0; d < N; ++d) {
+        out.min[d] = std::numeric_limits<RealT>::max();
+        out.max[d] = std::numeric_limits<RealT>::lowest();
+      }
+      return out;
+    }
+    return tf::transformed(_tree->nodes().front().aabb, _transformation);
+  }
+
+private:
+  const tf::tree<Index, RealT, N> *_tree;
+  tf::transformation<RealT, N> _transformation;
+  tf::transformation<RealT, N> _inverse_transformation;
+};
+
+/// @brief Create a view of a tree placed in the world by a rigid transformation.
+///
+/// @param tree The tree, built in the local frame. Must outlive the view.
+/// @param transformation A rigid transformation from the local frame into the world.
+/// @return A `tf::transformed_tree` instance.
+template <typename Index, typename RealT, std::size_t N>
+auto make_transformed_tree(const tf::tree<Index, RealT, N> &tree,
+                           const tf::transformation<RealT, N> &transformation)
+    -> transformed_tree<Index, RealT, N> {
+  return transformed_tree<Index, RealT, N>{tree, transformation};
+}
+
+} // namespace tf
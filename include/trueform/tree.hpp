@@ -6,6 +6,7 @@
 #pragma once
 
 #include "./implementation/build_tree_nodes.hpp"
+#include "./implementation/refit_tree_nodes.hpp"
 #include "./partitioning.hpp"
 #include "./tree_config.hpp"
 
@@ -108,6 +109,32 @@ public:
   }
 
 
+/// @brief Refit the tree to moved primitives, keeping its structure.
+///
+/// Recomputes the AABBs of the primitives, and the boxes of all nodes from
+/// the bottom up. The hierarchy and the primitive IDs of the leaves are kept,
+/// so refitting is cheaper than a rebuild, but the tree loses quality as the
+/// primitives move away from where it was built.
+///
+/// A @ref tf::pair_cache used with the tree detects the nodes whose boxes
+/// changed, and revalidates only the cached node pairs below them.
+///
+/// @param objects The range of primitives the tree was built over, at their
+///                new positions.
+/// @param config The configuration used to build the tree. Only `make_aabb`
+///               is used.
+  template <typename Range, typename FC>
+  auto refit(const Range &objects, const tf::tree_config<FC> &config) -> void {
+    if (!_nodes.size())
+      return;
+    tf::parallel_apply(std::forward_as_tuple(objects, _aabbs),
+                       [&](const auto &object, auto &aabb) {
+                         aabb = config.make_aabb(object);
+                       });
+    tf::implementation::refit_tree_nodes(_nodes, _ids, _aabbs, 0, 4);
+  }
+
+
 /// @brief Access the axis-aligned bounding boxes (AABBs) of the input primitives.
 ///
 /// Returns the buffer of primitive-level AABBs computed during tree construction.
@@ -129,6 +156,13 @@ public:
     return _nodes;
   }
 
+/// @brief Access the internal nodes of the tree.
+///
+/// @return A mutable reference to the node buffer.
+  auto nodes() -> tf::buffer<tf::tree_node<Index, RealT, N>> & {
+    return _nodes;
+  }
+
 
 /// @brief Access the leaf-level primitive ID buffer.
 ///
@@ -138,6 +172,11 @@ public:
 /// @return A constant reference to the primitive ID buffer.
   auto ids() const -> const tf::buffer<Index> & { return _ids; }
 
+/// @brief Access the leaf-level primitive ID buffer.
+///
+/// @return A mutable reference to the primitive ID buffer.
+  auto ids() -> tf::buffer<Index> & { return _ids; }
+
 
 /// @brief Clear all internal tree data.
 ///
@@ -7,9 +7,24 @@
 #include <algorithm>
 #include <iterator>
 #include <limits>
+#include <type_traits>
 
 namespace tf {
 
+namespace strategy {
+/// @brief Keep `tf::tree_knn` results sorted on every insertion.
+///
+/// Insertion is O(k). Best for small `k`. The default strategy.
+struct knn_sorted_t {};
+static constexpr knn_sorted_t knn_sorted;
+/// @brief Keep `tf::tree_knn` results in a bounded max-heap.
+///
+/// Insertion is O(log k). Results are unsorted until `tf::tree_knn::finalize`
+/// is called. Best for large `k`. Must be requested explicitly.
+struct knn_heap_t {};
+static constexpr knn_heap_t knn_heap;
+} // namespace strategy
+
 /// @brief Helper structure for k-nearest-neighbor (k-NN) queries in spatial trees.
 ///
 /// `tf::tree_knn` maintains a sorted buffer of up to `k` nearest elements during spatial traversal.
@@ -23,6 +38,11 @@ namespace tf {
 ///
 /// It supports optional radius-limited queries, which discard elements beyond the specified threshold.
 ///
+/// Results are kept sorted on every insertion (`tf::strategy::knn_sorted`, the default),
+/// or, when requested with `tf::strategy::knn_heap`, in a bounded max-heap. In heap mode,
+/// the results are unsorted until `finalize()` is called, which `tf::nearness_search`
+/// does on completion.
+///
 /// Use `tf::make_tree_knn` to create an instance.
 ///
 /// @tparam RandomIt A random-access iterator pointing to a buffer of `tf::tree_closest_point` or `tf::tree_closest_point_pair`.
@@ -34,45 +54,52 @@ template <typename RandomIt> class tree_knn {
 
 public:
   tree_knn(RandomIt out, std::size_t k, real_t radius)
-      : out(out), k(k), count(0), worst_metric{radius * radius} {}
+      : tree_knn(out, k, radius, false) {}
 
-  tree_knn(RandomIt out, std::size_t k)
-      : out(out), k(k), count(0),
-        worst_metric{std::numeric_limits<real_t>::max()} {}
+  tree_knn(RandomIt out, std::size_t k) : tree_knn(out, k, false) {}
+
+  tree_knn(strategy::knn_sorted_t, RandomIt out, std::size_t k, real_t radius)
+      : tree_knn(out, k, radius, false) {}
+
+  tree_knn(strategy::knn_sorted_t, RandomIt out, std::size_t k)
+      : tree_knn(out, k, false) {}
+
+  tree_knn(strategy::knn_heap_t, RandomIt out, std::size_t k, real_t radius)
+      : tree_knn(out, k, radius, true) {}
+
+  tree_knn(strategy::knn_heap_t, RandomIt out, std::size_t k)
+      : tree_knn(out, k, true) {}
 
   auto update(element_t element, const closest_point_t &point) -> void {
-    if (count < k) {
-      out[count++] = tree_closest_pt_t{element, point};
-      std::inplace_merge(
-          out, out + count - 1, out + count,
-          [](const auto &a, const auto &b) { return a.metric() < b.metric(); });
-      worst_metric = out[count - 1].metric();
-    } else if (point.metric < worst_metric) {
-      auto it = std::upper_bound(out, out + k - 1, point.metric,
-                                 [](const auto &value, const auto &elem) {
-                                   return value < elem.metric();
-                                 });
-      std::move_backward(it, out + k - 1, out + k);
-      *it = tree_closest_pt_t{element, point};
-      worst_metric = out[k - 1].metric();
-    }
+    if (!(point.metric < worst_metric))
+      return;
+    if (use_heap)
+      heap_update(element, point);
+    else
+      sorted_update(element, point);
   }
 
 /// @brief Return the current worst (farthest) distance among stored results.
 ///
-/// This value represents the squared distance of the farthest element in the current set.
-/// It is used during traversal to determine if a candidate should be inserted.
+/// Once `k` elements are stored, this is the squared distance of the k-th
+/// element. Before that, it is the squared search radius (or the maximal
+/// representable value). It is used during traversal to prune nodes and
+/// to determine if a candidate should be inserted.
 ///
 /// @return The current worst distance metric (squared).
   auto metric() const -> real_t { return worst_metric; }
 
 /// @brief Get an iterator to the beginning of the stored result buffer.
 ///
+/// In heap mode, the results are unsorted until `finalize()` is called.
+///
 /// @return Random-access iterator to the first stored result.
   auto begin() const -> RandomIt { return out; }
 
 /// @brief Get an iterator to one past the last stored result.
 ///
+/// In heap mode, the results are unsorted until `finalize()` is called.
+///
 /// @return Random-access iterator past the end of the current result set.
   auto end() const -> RandomIt { return out + count; }
 
@@ -83,6 +110,11 @@ public:
 /// @return Random-access iterator at the logical capacity (`out + k`).
   auto capacity() const -> RandomIt { return out + k; }
 
+/// @brief Return the number of requested neighbors.
+///
+/// @return The `k` this container was constructed with.
+  auto max_size() const -> std::size_t { return k; }
+
 /// @brief Return the number of currently stored results.
 ///
 /// @return The number of nearest neighbors currently held.
@@ -93,16 +125,90 @@ public:
 /// @return `true` if no results are stored; otherwise `false`.
   auto empty() const -> bool { return count == 0; }
 
+/// @brief Sort the stored results by metric.
+///
+/// A no-op for `tf::strategy::knn_sorted`. In heap mode, sorts the heap in
+/// place, so that the user buffer holds results ordered by distance.
+/// `tf::nearness_search` calls this on completion. Further updates restore
+/// the heap.
+  auto finalize() -> void {
+    if (!use_heap || is_sorted)
+      return;
+    std::sort_heap(out, out + count, less);
+    is_sorted = true;
+  }
+
+/// @brief Check whether results are kept in a bounded max-heap.
+///
+/// @return `true` for `tf::strategy::knn_heap`; otherwise `false`.
+  auto is_heap() const -> bool { return use_heap; }
+
 private:
+  tree_knn(RandomIt out, std::size_t k, real_t radius, bool use_heap)
+      : out(out), k(k), count(0), worst_metric{radius * radius},
+        use_heap{use_heap} {}
+
+  tree_knn(RandomIt out, std::size_t k, bool use_heap)
+      : out(out), k(k), count(0),
+        worst_metric{std::numeric_limits<real_t>::max()}, use_heap{use_heap} {}
+
+  static auto less(const tree_closest_pt_t &a, const tree_closest_pt_t &b)
+      -> bool {
+    return a.metric() < b.metric();
+  }
+
+  auto sorted_update(element_t element, const closest_point_t &point) -> void {
+    if (count < k) {
+      out[count++] = tree_closest_pt_t{element, point};
+      std::inplace_merge(out, out + count - 1, out + count, less);
+      // until k elements are found, the pruning bound
+      // remains the search radius
+      if (count == k)
+        worst_metric = out[k - 1].metric();
+    } else {
+      auto it = std::upper_bound(out, out + k - 1, point.metric,
+                                 [](const auto &value, const auto &elem) {
+                                   return value < elem.metric();
+                                 });
+      std::move_backward(it, out + k - 1, out + k);
+      *it = tree_closest_pt_t{element, point};
+      worst_metric = out[k - 1].metric();
+    }
+  }
+
+  auto heap_update(element_t element, const closest_point_t &point) -> void {
+    // results were sorted for reading, restore the heap
+    if (is_sorted) {
+      std::make_heap(out, out + count, less);
+      is_sorted = false;
+    }
+    if (count < k) {
+      out[count++] = tree_closest_pt_t{element, point};
+      std::push_heap(out, out + count, less);
+      if (count == k)
+        worst_metric = out[0].metric();
+    } else {
+      // the farthest element is at the root
+      std::pop_heap(out, out + k, less);
+      out[k - 1] = tree_closest_pt_t{element, point};
+      std::push_heap(out, out + k, less);
+      worst_metric = out[0].metric();
+    }
+  }
+
   RandomIt out;
   std::size_t k;
   std::size_t count;
   real_t worst_metric;
+  bool use_heap;
+  bool is_sorted = false;
 };
 
 
 /// @brief Construct a `tree_knn` container with automatic type deduction.
 ///
+/// Uses `tf::strategy::knn_sorted`.
+///
 /// @param iterator The output iterator pointing to a user-provided buffer.
 /// @param k The number of nearest neighbors to retain.
 /// @return A `tree_knn<RandomIt>` instance.
@@ -122,4 +228,34 @@ template <typename RandomIt, typename RealT>
 auto make_tree_knn(RandomIt iterator, std::size_t k, RealT radius) {
   return tree_knn<RandomIt>{iterator, k, radius};
 }
+
+/// @brief Construct a `tree_knn` container with an explicit storage strategy.
+///
+/// @param tag Either `tf::strategy::knn_sorted` or `tf::strategy::knn_heap`.
+/// @param iterator The output iterator pointing to a user-provided buffer.
+/// @param k The number of nearest neighbors to retain.
+/// @return A `tree_knn<RandomIt>` instance.
+template <typename Strategy, typename RandomIt>
+auto make_tree_knn(Strategy tag, RandomIt iterator, std::size_t k)
+    -> std::enable_if_t<std::is_same_v<Strategy, strategy::knn_sorted_t> ||
+                            std::is_same_v<Strategy, strategy::knn_heap_t>,
+                        tree_knn<RandomIt>> {
+  return tree_knn<RandomIt>{tag, iterator, k};
+}
+
+/// @brief Construct a radius-limited `tree_knn` container with an explicit storage strategy.
+///
+/// @param tag Either `tf::strategy::knn_sorted` or `tf::strategy::knn_heap`.
+/// @param iterator The output iterator pointing to a user-provided buffer.
+/// @param k The number of nearest neighbors to retain.
+/// @param radius The query radius. Only neighbors within this distance are considered.
+/// @return A `tree_knn<RandomIt>` instance.
+template <typename Strategy, typename RandomIt, typename RealT>
+auto make_tree_knn(Strategy tag, RandomIt iterator, std::size_t k,
+                   RealT radius)
+    -> std::enable_if_t<std::is_same_v<Strategy, strategy::knn_sorted_t> ||
+                            std::is_same_v<Strategy, strategy::knn_heap_t>,
+                        tree_knn<RandomIt>> {
+  return tree_knn<RandomIt>{tag, iterator, k, radius};
+}
 } // namespace tf
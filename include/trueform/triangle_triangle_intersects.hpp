@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025 Žiga Sajovic, XLAB
+ * Distributed under the Boost Software License, Version 1.0.
+ * https://github.com/xlabmedical/trueform
+ */
+#pragma once
+#include "./orient2d.hpp"
+#include "./orient3d.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace tf::implementation {
+
+using projected_point = std::array<double, 2>;
+
+inline auto projected_on_segment(const projected_point &a,
+                                 const projected_point &b,
+                                 const projected_point &p) -> bool {
+  return std::min(a[0], b[0]) <= p[0] && p[0] <= std::max(a[0], b[0]) &&
+         std::min(a[1], b[1]) <= p[1] && p[1] <= std::max(a[1], b[1]);
+}
+
+// closed segments [a, b] and [c, d]
+inline auto projected_segments_intersect(const projected_point &a,
+                                         const projected_point &b,
+                                         const projected_point &c,
+                                         const projected_point &d) -> bool {
+  int o0 = tf::orient2d(a, b, c);
+  int o1 = tf::orient2d(a, b, d);
+  int o2 = tf::orient2d(c, d, a);
+  int o3 = tf::orient2d(c, d, b);
+  if (o0 * o1 < 0 && o2 * o3 < 0)
+    return true;
+  return (o0 == 0 && projected_on_segment(a, b, c)) ||
+         (o1 == 0 && projected_on_segment(a, b, d)) ||
+         (o2 == 0 && projected_on_segment(c, d, a)) ||
+         (o3 == 0 && projected_on_segment(c, d, b));
+}
+
+// closed, non-degenerate triangle
+inline auto projected_triangle_contains(const projected_point *t,
+                                        const projected_point &p) -> bool {
+  int o0 = tf::orient2d(t[0], t[1], p);
+  int o1 = tf::orient2d(t[1], t[2], p);
+  int o2 = tf::orient2d(t[2], t[0], p);
+  return !((o0 < 0 || o1 < 0 || o2 < 0) && (o0 > 0 || o1 > 0 || o2 > 0));
+}
+
+// Both triangles lie in one plane. They are projected onto the coordinate
+// plane that drops the axis along which the normal is largest. The choice
+// is certified exactly: the projected orientation is the sign of the
+// dropped component of the normal.
+template <typename Point>
+auto coplanar_triangles_intersect(const Point *t0, const Point *t1) -> bool {
+  std::array<double, 3> normal{0, 0, 0};
+  for (const Point *t : {t0, t1}) {
+    double e0[3], e1[3];
+    for (int i = 0; i < 3; ++i) {
+      e0[i] = double(t[1][i]) - double(t[0][i]);
+      e1[i] = double(t[2][i]) - double(t[0][i]);
+    }
+    normal[0] += std::abs(e0[1] * e1[2] - e0[2] * e1[1]);
+    normal[1] += std::abs(e0[2] * e1[0] - e0[0] * e1[2]);
+    normal[2] += std::abs(e0[0] * e1[1] - e0[1] * e1[0]);
+  }
+  std::array<int, 3> axes{0, 1, 2};
+  std::sort(axes.begin(), axes.end(),
+            [&](int a, int b) { return normal[a] > normal[b]; });
+  projected_point p0[3], p1[3];
+  for (int axis : axes) {
+    int i0 = (axis + 1) % 3, i1 = (axis + 2) % 3;
+    for (int i = 0; i < 3; ++i) {
+      p0[i] = {double(t0[i][i0]), double(t0[i][i1])};
+      p1[i] = {double(t1[i][i0]), double(t1[i][i1])};
+    }
+    if (tf::orient2d(p0[0], p0[1], p0[2]) != 0 &&
+        tf::orient2d(p1[0], p1[1], p1[2]) != 0)
+      break;
+  }
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      if (projected_segments_intersect(p0[i], p0[(i + 1) % 3], p1[j],
+                                       p1[(j + 1) % 3]))
+        return true;
+  return projected_triangle_contains(p1, p0[0]) ||
+         projected_triangle_contains(p0, p1[0]);
+}
+
+// p0 and p1 are each alone on their side of the plane of the other triangle,
+// and the triangles are oriented accordingly. The segments in which the
+// triangles cut the line of the two planes overlap iff neither of the two
+// orientations is positive.
+template <typename Point>
+auto triangle_intervals_overlap(const Point &p0, const Point &q0,
+                                const Point &r0, const Point &p1,
+                                const Point &q1, const Point &r1) -> bool {
+  if (tf::orient3d(p1, p0, q1, q0) > 0)
+    return false;
+  if (tf::orient3d(p1, r0, r1, p0) > 0)
+    return false;
+  return true;
+}
+
+// p0 is alone on its side of the plane of the second triangle. Permutes the
+// second triangle so that p1 is alone on its side of the plane of the first.
+template <typename Point>
+auto triangle_triangle_intersects(const Point &p0, const Point &q0,
+                                  const Point &r0, const Point &p1,
+                                  const Point &q1, const Point &r1, int dp1,
+                                  int dq1, int dr1, const Point *t0,
+                                  const Point *t1) -> bool {
+  if (dp1 > 0) {
+    if (dq1 > 0)
+      return triangle_intervals_overlap(p0, r0, q0, r1, p1, q1);
+    if (dr1 > 0)
+      return triangle_intervals_overlap(p0, r0, q0, q1, r1, p1);
+    return triangle_intervals_overlap(p0, q0, r0, p1, q1, r1);
+  }
+  if (dp1 < 0) {
+    if (dq1 < 0)
+      return triangle_intervals_overlap(p0, q0, r0, r1, p1, q1);
+    if (dr1 < 0)
+      return triangle_intervals_overlap(p0, q0, r0, q1, r1, p1);
+    return triangle_intervals_overlap(p0, r0, q0, p1, q1, r1);
+  }
+  if (dq1 < 0) {
+    if (dr1 >= 0)
+      return triangle_intervals_overlap(p0, r0, q0, q1, r1, p1);
+    return triangle_intervals_overlap(p0, q0, r0, p1, q1, r1);
+  }
+  if (dq1 > 0) {
+    if (dr1 > 0)
+      return triangle_intervals_overlap(p0, r0, q0, p1, q1, r1);
+    return triangle_intervals_overlap(p0, q0, r0, q1, r1, p1);
+  }
+  if (dr1 > 0)
+    return triangle_intervals_overlap(p0, q0, r0, r1, p1, q1);
+  if (dr1 < 0)
+    return triangle_intervals_overlap(p0, r0, q0, r1, p1, q1);
+  return coplanar_triangles_intersect(t0, t1);
+}
+} // namespace tf::implementation
+
+namespace tf {
+
+/// @brief Check whether two triangles in 3D intersect.
+///
+/// Triangles are closed: touching at a vertex or along an edge counts as
+/// an intersection. Follows Guigue and Devillers, "Fast and Robust
+/// Triangle-Triangle Overlap Test Using Orientation Predicates": the
+/// vertices of each triangle are classified against the plane of the
+/// other, and the intervals on the intersection line of the planes are
+/// compared with two further orientations. Coplanar triangles are tested
+/// in a projection onto a coordinate plane.
+///
+/// All decisions are made with the filtered exact predicates
+/// @ref tf::orient3d and @ref tf::orient2d, so the result is exact for
+/// `float` and `double` coordinates. Most calls never leave the double
+/// precision filter. The triangles are assumed non-degenerate.
+///
+/// @param triangle0 A range of three points.
+/// @param triangle1 A range of three points.
+///
+/// @return `true` if the triangles intersect; otherwise `false`.
+template <typename Range0, typename Range1>
+auto triangle_triangle_intersects(const Range0 &triangle0,
+                                  const Range1 &triangle1) -> bool {
+  using point_t = std::array<double, 3>;
+  auto to_point = [](const auto &pt) {
+    return point_t{double(pt[0]), double(pt[1]), double(pt[2])};
+  };
+  point_t t0[3] = {to_point(triangle0[0]), to_point(triangle0[1]),
+                   to_point(triangle0[2])};
+  point_t t1[3] = {to_point(triangle1[0]), to_point(triangle1[1]),
+                   to_point(triangle1[2])};
+  const auto &[p0, q0, r0] = t0;
+  const auto &[p1, q1, r1] = t1;
+  // the first triangle against the plane of the second
+  int dp0 = tf::orient3d(p0, p1, q1, r1);
+  int dq0 = tf::orient3d(q0, p1, q1, r1);
+  int dr0 = tf::orient3d(r0, p1, q1, r1);
+  if (dp0 * dq0 > 0 && dp0 * dr0 > 0)
+    return false;
+  // the second triangle against the plane of the first
+  int dp1 = tf::orient3d(p1, p0, q0, r0);
+  int dq1 = tf::orient3d(q1, p0, q0, r0);
+  int dr1 = tf::orient3d(r1, p0, q0, r0);
+  if (dp1 * dq1 > 0 && dp1 * dr1 > 0)
+    return false;
+  using implementation::triangle_triangle_intersects;
+  // rotate the first triangle so that p0 is alone on its side, and make
+  // that side positive by swapping the orientation of the second
+  if (dp0 > 0) {
+    if (dq0 > 0)
+      return triangle_triangle_intersects(r0, p0, q0, p1, r1, q1, dp1, dr1,
+                                          dq1, t0, t1);
+    if (dr0 > 0)
+      return triangle_triangle_intersects(q0, r0, p0, p1, r1, q1, dp1, dr1,
+                                          dq1, t0, t1);
+    return triangle_triangle_intersects(p0, q0, r0, p1, q1, r1, dp1, dq1, dr1,
+                                        t0, t1);
+  }
+  if (dp0 < 0) {
+    if (dq0 < 0)
+      return triangle_triangle_intersects(r0, p0, q0, p1, q1, r1, dp1, dq1,
+                                          dr1, t0, t1);
+    if (dr0 < 0)
+      return triangle_triangle_intersects(q0, r0, p0, p1, q1, r1, dp1, dq1,
+                                          dr1, t0, t1);
+    return triangle_triangle_intersects(p0, q0, r0, p1, r1, q1, dp1, dr1, dq1,
+                                        t0, t1);
+  }
+  if (dq0 < 0) {
+    if (dr0 >= 0)
+      return triangle_triangle_intersects(q0, r0, p0, p1, r1, q1, dp1, dr1,
+                                          dq1, t0, t1);
+    return triangle_triangle_intersects(p0, q0, r0, p1, q1, r1, dp1, dq1, dr1,
+                                        t0, t1);
+  }
+  if (dq0 > 0) {
+    if (dr0 > 0)
+      return triangle_triangle_intersects(p0, q0, r0, p1, r1, q1, dp1, dr1,
+                                          dq1, t0, t1);
+    return triangle_triangle_intersects(q0, r0, p0, p1, q1, r1, dp1, dq1, dr1,
+                                        t0, t1);
+  }
+  if (dr0 > 0)
+    return triangle_triangle_intersects(r0, p0, q0, p1, q1, r1, dp1, dq1, dr1,
+                                        t0, t1);
+  if (dr0 < 0)
+    return triangle_triangle_intersects(r0, p0, q0, p1, r1, q1, dp1, dr1, dq1,
+                                        t0, t1);
+  return implementation::coplanar_triangles_intersect(t0, t1);
+}
+
+} // namespace tf
@@ -28,17 +28,27 @@
 #include "./aabb_from.hpp"
 #include "./aabb_metrics.hpp"
 #include "./aabb_union.hpp"
+#include "./closest_feature_on_triangle.hpp"
 #include "./closest_point.hpp"
 #include "./closest_point_on_triangle.hpp"
 #include "./closest_point_pair.hpp"
+#include "./closest_points_on_triangles.hpp"
 #include "./distance.hpp"
 #include "./dot.hpp"
 #include "./intersects.hpp"
+#include "./inverted.hpp"
+#include "./maximal_distance.hpp"
+#include "./mesh_pseudonormals.hpp"
 #include "./minimal_maximal_distance.hpp"
 #include "./normalize.hpp"
 #include "./normalized.hpp"
+#include "./orient2d.hpp"
+#include "./orient3d.hpp"
+#include "./ray.hpp"
 #include "./transformation.hpp"
 #include "./transformed.hpp"
+#include "./transformed_aabb_intersects.hpp"
+#include "./triangle_triangle_intersects.hpp"
 #include "./vector.hpp"
 #include "./vector_view.hpp"
 /** @} */
@@ -80,6 +90,8 @@
  */
 #include "./tree.hpp"
 #include "./mod_tree.hpp"
+#include "./scene_tree.hpp"
+#include "./transformed_tree.hpp"
 #include "./tree_config.hpp"
 #include "./tree_node.hpp"
 #include "./partitioning.hpp"
@@ -93,11 +105,33 @@
  *
  *  @{
  */
+#include "./approximation.hpp"
+#include "./earliest_contact.hpp"
+#include "./fast_winding_number.hpp"
+#include "./hausdorff_distance.hpp"
+#include "./mesh_intersection_curves.hpp"
+#include "./mesh_self_intersections.hpp"
+#include "./motion.hpp"
+#include "./nearness_hint.hpp"
 #include "./nearness_search.hpp"
+#include "./nearness_search_broad.hpp"
+#include "./pair_cache.hpp"
+#include "./project_points.hpp"
+#include "./ray_cast.hpp"
+#include "./query_budget.hpp"
+#include "./radius_search.hpp"
 #include "./search.hpp"
 #include "./search_broad.hpp"
+#include "./search_collect.hpp"
+#include "./search_count.hpp"
 #include "./search_self.hpp"
 #include "./search_self_broad.hpp"
+#include "./search_self_collect.hpp"
+#include "./search_self_count.hpp"
+#include "./sdf_grid.hpp"
+#include "./search_self_scene.hpp"
+#include "./signed_distance.hpp"
+#include "./time_interval.hpp"
 #include "./tree_closest_point.hpp"
 #include "./tree_closest_point_pair.hpp"
 #include "./tree_knn.hpp"